@@ -24,7 +24,7 @@ UserFunctionExpr::Parameter::Parameter(const StringId & _name,ptr_t defaultValue
 //! (ctor)
 UserFunctionExpr::UserFunctionExpr(AST::Block * block,const refArray_t & _sConstrExpressions,int _line):
 		ASTNode(TYPE_USER_FUNCTION_EXPRESSION,true,_line),
-		blockRef(block), sConstrExpressions(_sConstrExpressions){
+		blockRef(block), sConstrExpressions(_sConstrExpressions),staticVarsDeclared(false){
 	//ctor
 }
 
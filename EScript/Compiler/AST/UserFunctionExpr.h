@@ -70,11 +70,16 @@ class UserFunctionExpr : public ASTNode {
 
 		void setCode(const CodeFragment & _code)				{	code = _code;	}
 
+		//! The body (or the body of a nested function) declares static variables.
+		bool declaresStaticVars()const							{	return staticVarsDeclared;	}
+		void markAsDeclaringStaticVars()						{	staticVarsDeclared = true;	}
+
 	private:
 		ERef<Block> blockRef;
 		parameterList_t params;
 		refArray_t sConstrExpressions;
 		CodeFragment code;
+		bool staticVarsDeclared;
 	//	@}
 };
 }
@@ -0,0 +1,392 @@
+// CodeImage.cpp
+// This file is part of the EScript programming language (https://github.com/EScript)
+//
+// Copyright (C) 2026 The EScript contributors
+//
+// Licensed under the MIT License. See LICENSE file for details.
+// ---------------------------------------------------------------------------------
+#include "CodeImage.h"
+#include "../Consts.h"
+#include "../Objects/Callables/UserFunction.h"
+#include "../Objects/Exception.h"
+#include "../Instructions/Instruction.h"
+#include "../Instructions/InstructionBlock.h"
+#include "../Utils/CodeFragment.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace EScript{
+
+namespace{
+const char magic[8] = {'\x7f','E','S','C','O','D','E','\0'};
+const uint32_t formatVersion = 6;
+const uint32_t byteOrderMark = 0x01020304;
+
+//! Instructions whose value is an identifier.
+bool hasIdentifierValue(Instruction::type_t type){
+	switch(type){
+		case Instruction::I_ASSIGN_ATTRIBUTE:
+		case Instruction::I_ASSIGN_VARIABLE:
+		case Instruction::I_GET_ATTRIBUTE:
+		case Instruction::I_PUSH_ID:
+		case Instruction::I_SET_ATTRIBUTE:
+			return true;
+		default:
+			return false;
+	}
+}
+//! Instructions whose value is an identifier and a uint32 value.
+bool hasIdentifierPairValue(Instruction::type_t type){
+	return type==Instruction::I_FIND_VARIABLE || type==Instruction::I_GET_VARIABLE
+			|| type==Instruction::I_GET_LOCAL_AND_ATTRIBUTE || type==Instruction::I_GET_LOCAL_ATTRIBUTE;
+}
+
+class ImageWriter{
+		std::string data;
+		std::vector<StringId> identifiers;
+		std::unordered_map<StringId,uint32_t> identifierIndices;
+		const std::string * sourceCode;
+	public:
+		ImageWriter() : sourceCode(nullptr){}
+
+		void writeUInt8(uint8_t v)	{	data.push_back(static_cast<char>(v));	}
+		void writeUInt32(uint32_t v)	{	data.append(reinterpret_cast<const char*>(&v),sizeof(v));	}
+		void writeInt32(int32_t v)		{	data.append(reinterpret_cast<const char*>(&v),sizeof(v));	}
+		void writeUInt64(uint64_t v)	{	data.append(reinterpret_cast<const char*>(&v),sizeof(v));	}
+		void writeDouble(double v)		{	data.append(reinterpret_cast<const char*>(&v),sizeof(v));	}
+		void writeString(const std::string & s){
+			writeUInt32(static_cast<uint32_t>(s.length()));
+			data.append(s);
+		}
+		void writeIdentifier(const StringId & id)	{	writeUInt32(getIdentifierIndex(id));	}
+		uint32_t getIdentifierIndex(const StringId & id){
+			const auto it = identifierIndices.find(id);
+			if(it!=identifierIndices.end())
+				return it->second;
+			const uint32_t index = static_cast<uint32_t>(identifiers.size());
+			identifiers.push_back(id);
+			identifierIndices[id] = index;
+			return index;
+		}
+
+		void writeFunction(const UserFunction * fun){
+			const CodeFragment & code = fun->getCode();
+			if(!sourceCode)
+				sourceCode = &code.getFullCode();
+			else if(sourceCode!=&code.getFullCode())
+				throw new Exception("CodeImage: All functions have to be compiled from the same code.");
+
+			writeInt32(fun->getLine());
+			writeUInt64(fun->getParamCount());
+			writeInt32(fun->getMinParamCount());
+			writeInt32(fun->getMaxParamCount());
+			writeInt32(fun->getMultiParam());
+			writeUInt64(code.getStartPos());
+			writeUInt64(code.getLength());
+			writeUInt8(fun->getStaticData()!=nullptr ? 1 : 0);
+
+			const InstructionBlock & block = fun->getInstructionBlock();
+			writeUInt32(static_cast<uint32_t>(block.getLocalVariables().size()));
+			for(const auto & name : block.getLocalVariables())
+				writeIdentifier(name);
+			writeUInt32(static_cast<uint32_t>(block.getStringConstants().size()));
+			for(const auto & str : block.getStringConstants())
+				writeString(str.str());
+			writeUInt32(static_cast<uint32_t>(block.getNumberConstants().size()));
+			for(const double number : block.getNumberConstants())
+				writeDouble(number);
+			writeUInt32(static_cast<uint32_t>(block.getInstructions().size()));
+			for(size_t index = 0; index<block.getInstructions().size(); ++index){
+				Instruction i(block.getInstruction(index));
+				if(hasIdentifierValue(i.getType())){
+					i.setValue_uint32(getIdentifierIndex(i.getValue_Identifier()));
+				}else if(hasIdentifierPairValue(i.getType())){
+					const std::pair<uint32_t,uint32_t> value = i.getValue_uint32Pair();
+					i.setValue_uint32Pair(getIdentifierIndex(StringId(value.first)),value.second);
+				}
+				writeUInt32(static_cast<uint32_t>(i.getType()));
+				writeInt32(block.getLine(index));
+				writeUInt64(i._getRawValue());
+			}
+			writeUInt32(static_cast<uint32_t>(block.getInternalFunctions().size()));
+			for(const auto & internalFunction : block.getInternalFunctions()){
+				UserFunction * internalUserFunction = internalFunction.castTo<UserFunction>();
+				if(!internalUserFunction)
+					throw new Exception("CodeImage: Unsupported internal function.");
+				internalUserFunction->compile(); // the image contains the instructions of all functions
+				writeFunction(internalUserFunction);
+			}
+		}
+
+		std::string finish(const UserFunction * fun,const StaticData * staticData){
+			std::string functions;
+			functions.swap(data);
+
+			writeString(sourceCode ? *sourceCode : std::string());
+			writeIdentifier(StringId(fun->getCode().getFilename()));
+			const std::vector<StringId> noStaticVariables;
+			const auto & staticVariableNames = staticData ? staticData->getStaticVariableNames() : noStaticVariables;
+			writeUInt32(static_cast<uint32_t>(staticVariableNames.size()));
+			for(const auto & name : staticVariableNames)
+				writeIdentifier(name);
+			std::string body;
+			body.swap(data);
+
+			// the identifiers are collected while writing the other parts, but are read first
+			data.append(magic,sizeof(magic));
+			writeUInt32(formatVersion);
+			writeUInt32(byteOrderMark);
+			writeUInt32(sizeof(Instruction));
+			writeUInt32(static_cast<uint32_t>(identifiers.size()));
+			for(const auto & id : identifiers)
+				writeString(id.toString());
+			return data + body + functions;
+		}
+};
+
+class ImageReader{
+		//! Size of a function without local variables, constants, instructions and internal functions.
+		static const size_t minFunctionSize = 3*sizeof(uint64_t)+9*sizeof(uint32_t)+sizeof(uint8_t);
+
+		const std::string & data;
+		size_t pos;
+		std::vector<StringId> identifiers;
+		StringData sourceCode;
+		StringId filename;
+		_CountedRef<StaticData> staticData;
+	public:
+		ImageReader(const std::string & _data) : data(_data),pos(0){}
+
+		static void invalidImage(const std::string & reason){
+			throw new Exception("Invalid code image: "+reason);
+		}
+		void read(void * target,size_t size){
+			if(size>data.size()-pos)
+				invalidImage("unexpected end of data.");
+			std::memcpy(target,data.data()+pos,size);
+			pos += size;
+		}
+		uint8_t readUInt8()		{	uint8_t v;	read(&v,sizeof(v));	return v;	}
+		uint32_t readUInt32()	{	uint32_t v;	read(&v,sizeof(v));	return v;	}
+		int32_t readInt32()		{	int32_t v;	read(&v,sizeof(v));	return v;	}
+		uint64_t readUInt64()	{	uint64_t v;	read(&v,sizeof(v));	return v;	}
+		double readDouble()		{	double v;	read(&v,sizeof(v));	return v;	}
+		std::string readString(){
+			const uint32_t length = readUInt32();
+			if(length>data.size()-pos)
+				invalidImage("unexpected end of data.");
+			std::string s(data,pos,length);
+			pos += length;
+			return s;
+		}
+		//! Read the number of the following elements; every element occupies at least @p minElementSize bytes.
+		uint32_t readCount(size_t minElementSize){
+			const uint32_t count = readUInt32();
+			if(count>(data.size()-pos)/minElementSize)
+				invalidImage("invalid element count.");
+			return count;
+		}
+		StringId readIdentifier()	{	return getIdentifier(readUInt32());	}
+		StringId getIdentifier(uint32_t index)const{
+			if(index>=identifiers.size())
+				invalidImage("invalid identifier.");
+			return identifiers[index];
+		}
+
+		void readHeader(){
+			char m[sizeof(magic)];
+			read(m,sizeof(m));
+			if(std::memcmp(m,magic,sizeof(magic))!=0)
+				invalidImage("no code image.");
+			if(readUInt32()!=formatVersion || readUInt32()!=byteOrderMark || readUInt32()!=sizeof(Instruction))
+				invalidImage("incompatible version or platform.");
+			identifiers.resize(readCount(sizeof(uint32_t)));
+			for(auto & id : identifiers)
+				id = StringId(readString());
+			sourceCode = StringData(readString());
+			filename = readIdentifier();
+			staticData = new StaticData;
+			const uint32_t numStaticVariables = readCount(sizeof(uint32_t));
+			for(uint32_t i = 0; i<numStaticVariables; ++i)
+				staticData->declareStaticVariable(readIdentifier());
+		}
+
+		ERef<UserFunction> readFunction(){
+			ERef<UserFunction> fun = new UserFunction;
+			fun->setLine(readInt32());
+			const uint64_t paramCount = readUInt64();
+			const int minParamValueCount = readInt32();
+			const int maxParamValueCount = readInt32();
+			const int multiParam = readInt32();
+			const size_t start = static_cast<size_t>(readUInt64());
+			const size_t length = static_cast<size_t>(readUInt64());
+			if(start>sourceCode.getDataSize() || length>sourceCode.getDataSize()-start)
+				invalidImage("invalid code range.");
+			fun->setCode(CodeFragment(filename,sourceCode,start,length));
+			if(readUInt8()!=0)
+				fun->setStaticData(_CountedRef<StaticData>(staticData));
+
+			InstructionBlock & block = fun->getInstructionBlock();
+			const uint32_t numLocalVariables = readCount(sizeof(uint32_t));
+			if(numLocalVariables<block.getNumLocalVars())
+				invalidImage("missing local variables.");
+			for(uint32_t i = 0; i<numLocalVariables; ++i){
+				const StringId name = readIdentifier();
+				if(i>=block.getNumLocalVars()) // the magic variables are declared by the InstructionBlock
+					block.declareLocalVariable(name);
+			}
+			// the parameters are the local variables following the magic variables
+			if(paramCount>numLocalVariables-Consts::LOCAL_VAR_INDEX_firstParameter
+					|| minParamValueCount<0 || static_cast<uint64_t>(minParamValueCount)>paramCount
+					|| (multiParam<0 && (maxParamValueCount<minParamValueCount || static_cast<uint64_t>(maxParamValueCount)>paramCount))
+					|| (multiParam>=0 && (static_cast<uint64_t>(multiParam)>=paramCount || maxParamValueCount!=-1)))
+				invalidImage("invalid parameters.");
+			fun->setParameterCounts(static_cast<size_t>(paramCount),minParamValueCount,maxParamValueCount);
+			fun->setMultiParam(multiParam);
+
+			const uint32_t numStringConstants = readCount(sizeof(uint32_t));
+			for(uint32_t i = 0; i<numStringConstants; ++i)
+				block.declareString(readString());
+			const uint32_t numNumberConstants = readCount(sizeof(double));
+			for(uint32_t i = 0; i<numNumberConstants; ++i){
+				if(block.declareNumber(readDouble())!=i) // the instructions reference the constants by index
+					invalidImage("duplicate number constant.");
+			}
+
+			const uint32_t numInstructions = readCount(2*sizeof(uint32_t)+sizeof(uint64_t));
+			const uint32_t numStaticVariables = static_cast<uint32_t>(staticData->getStaticVariableNames().size());
+			uint32_t numOnceStatements = 0;
+			uint32_t numGlobalVarCaches = 0;
+			uint32_t numCallSites = 0;
+			uint32_t numUsedFunctions = 0;
+			for(uint32_t i = 0; i<numInstructions; ++i){
+				const uint32_t type = readUInt32();
+				if(type>static_cast<uint32_t>(Instruction::I_SET_MARKER))
+					invalidImage("invalid instruction.");
+				const int line = readInt32();
+				Instruction instruction = Instruction::_createFromRawValue(static_cast<Instruction::type_t>(type),readUInt64());
+				const uint32_t value = instruction.getValue_uint32();
+				const std::pair<uint32_t,uint32_t> valuePair = instruction.getValue_uint32Pair();
+
+				// the operands are checked against the function's tables, so that the Runtime never accesses them out of range
+				bool valid = true;
+				switch(instruction.getType()){
+					case Instruction::I_ASSIGN_LOCAL:
+					case Instruction::I_CHECK_CONSTRAINT:
+					case Instruction::I_GET_LOCAL_VARIABLE:
+					case Instruction::I_RESET_LOCAL_VARIABLE:
+						valid = value<numLocalVariables;
+						break;
+					case Instruction::I_GET_LOCAL_AND_ATTRIBUTE:
+					case Instruction::I_GET_LOCAL_ATTRIBUTE:
+						valid = valuePair.second<numLocalVariables;
+						break;
+					case Instruction::I_ASSIGN_STATIC_VARIABLE:
+					case Instruction::I_GET_STATIC_VARIABLE:
+						valid = fun->getStaticData()!=nullptr && value<numStaticVariables;
+						break;
+					case Instruction::I_PUSH_STRING:
+						valid = value<numStringConstants;
+						break;
+					case Instruction::I_PUSH_NUMBER:
+						valid = value<numNumberConstants;
+						break;
+					case Instruction::I_PUSH_FUNCTION: // the internal functions follow the instructions
+						numUsedFunctions = std::max(numUsedFunctions,value+1);
+						break;
+					case Instruction::I_JMP:
+					case Instruction::I_JMP_IF_SET:
+					case Instruction::I_JMP_ON_TRUE:
+					case Instruction::I_JMP_ON_FALSE:
+					case Instruction::I_SET_EXCEPTION_HANDLER:
+						valid = value<=numInstructions || value==Instruction::INVALID_JUMP_ADDRESS;
+						break;
+					case Instruction::I_ONCE_ENTER: // every @(once) statement has its own enter instruction
+						valid = valuePair.first<numInstructions
+								&& (valuePair.second<=numInstructions || valuePair.second==Instruction::INVALID_JUMP_ADDRESS);
+						numOnceStatements = std::max(numOnceStatements,valuePair.first+1);
+						break;
+					case Instruction::I_ONCE_LEAVE:
+						valid = value<numInstructions;
+						numOnceStatements = std::max(numOnceStatements,value+1);
+						break;
+					case Instruction::I_FIND_VARIABLE: // every non-local variable access has its own cache
+					case Instruction::I_GET_VARIABLE:
+						valid = valuePair.second<numInstructions;
+						numGlobalVarCaches = std::max(numGlobalVarCaches,valuePair.second+1);
+						break;
+					case Instruction::I_CALL: // every parameter is pushed by at least one instruction
+					case Instruction::I_TAIL_CALL:
+						valid = (valuePair.first<numInstructions || valuePair.first==Consts::DYNAMIC_PARAMETER_COUNT)
+								&& (valuePair.second<numInstructions || valuePair.second==Instruction::NO_CALL_SITE_FEEDBACK);
+						if(valuePair.second!=Instruction::NO_CALL_SITE_FEEDBACK)
+							numCallSites = std::max(numCallSites,valuePair.second+1);
+						break;
+					case Instruction::I_CREATE_INSTANCE:
+					case Instruction::I_INIT_CALLER:
+						valid = value<numInstructions || value==Consts::DYNAMIC_PARAMETER_COUNT;
+						break;
+					case Instruction::I_SYS_CALL:
+						valid = valuePair.first<Consts::NUM_SYS_CALLS
+								&& (valuePair.second<numInstructions || valuePair.second==Consts::DYNAMIC_PARAMETER_COUNT);
+						break;
+					default:
+						break;
+				}
+				if(!valid)
+					invalidImage("invalid instruction operand.");
+				if(hasIdentifierValue(instruction.getType())){
+					instruction.setValue_Identifier(getIdentifier(value));
+				}else if(hasIdentifierPairValue(instruction.getType())){
+					instruction.setValue_uint32Pair(getIdentifier(valuePair.first).getValue(),valuePair.second);
+				}
+				block.addInstruction(instruction,line);
+			}
+			block.initSwitchTables();
+			block.finishConstantDeclarations();
+			fun->initOnceStatements(numOnceStatements);
+			fun->initGlobalVariableCaches(numGlobalVarCaches);
+			fun->initCallSiteFeedback(numCallSites);
+			fun->initAccessor();
+
+			const uint32_t numInternalFunctions = readCount(minFunctionSize);
+			if(numUsedFunctions>numInternalFunctions)
+				invalidImage("invalid function index.");
+			for(uint32_t i = 0; i<numInternalFunctions; ++i)
+				block.registerInternalFunction(readFunction().get());
+			return fun;
+		}
+
+		std::pair<ERef<UserFunction>,_CountedRef<StaticData>> readImage(){
+			readHeader();
+			ERef<UserFunction> fun = readFunction();
+			if(pos!=data.size())
+				invalidImage("unexpected data.");
+			return std::make_pair(std::move(fun),std::move(staticData));
+		}
+};
+}
+
+//! (static)
+bool CodeImage::isCodeImage(const std::string & data){
+	return data.size()>=sizeof(magic) && std::memcmp(data.data(),magic,sizeof(magic))==0;
+}
+
+//! (static)
+std::string CodeImage::create(const UserFunction * fun,const StaticData * staticData){
+	ImageWriter writer;
+	writer.writeFunction(fun);
+	return writer.finish(fun,staticData);
+}
+
+//! (static)
+std::pair<ERef<UserFunction>,_CountedRef<StaticData>> CodeImage::load(const std::string & image){
+	ImageReader reader(image);
+	return reader.readImage();
+}
+
+}
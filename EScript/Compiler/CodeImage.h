@@ -0,0 +1,43 @@
+// CodeImage.h
+// This file is part of the EScript programming language (https://github.com/EScript)
+//
+// Copyright (C) 2026 The EScript contributors
+//
+// Licensed under the MIT License. See LICENSE file for details.
+// ---------------------------------------------------------------------------------
+#ifndef ES_CODE_IMAGE_H
+#define ES_CODE_IMAGE_H
+
+#include "../Utils/ObjRef.h"
+
+#include <string>
+#include <utility>
+
+namespace EScript {
+
+class UserFunction;
+class StaticData;
+
+/*! Binary image of compiled code: a UserFunction created by the Compiler, its nested functions
+	(including their InstructionBlocks) and the declared static variables. Loading an image replaces
+	parsing and compiling the script. The image also contains the source code, which is used for
+	debug output. Identifiers are stored as strings, but the instructions are stored as they are,
+	so an image can only be loaded by the same EScript version on the same platform.	*/
+class CodeImage {
+	public:
+		//! (static) Returns true iff the data starts like a code image.
+		static bool isCodeImage(const std::string & data);
+
+		/*! (static) Create an image of a compilation unit as returned by Compiler::compile(...).
+			The static variables' values are not stored.	*/
+		static std::string create(const UserFunction * fun,const StaticData * staticData);
+
+		/*! (static) Recreate the compilation unit stored in the image.
+			If the image is invalid, an Exception is thrown: all counts and all operands referring to the
+			function's constants, variables, instructions and nested functions are checked. The stack usage
+			of the instructions is not checked, but stack underflows are detected by the Runtime.	*/
+		static std::pair<ERef<UserFunction>,_CountedRef<StaticData>> load(const std::string & image);
+};
+
+}
+#endif // ES_CODE_IMAGE_H
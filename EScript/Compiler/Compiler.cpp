@@ -26,6 +26,7 @@
 #include "AST/ValueExpr.h"
 #include "../Objects/Callables/UserFunction.h"
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <map>
@@ -78,6 +79,9 @@ std::pair<ERef<UserFunction>,_CountedRef<StaticData>>
 		FnCompileContext ctxt(*this,*staticData.get(),fun->getInstructionBlock(),code);
 		ctxt.addExpression(syntaxTreeRoot.get());
 		Compiler::finalizeInstructions(fun->getInstructionBlock());
+		fun->initOnceStatements(ctxt.getNumOnceStatements());
+		fun->initGlobalVariableCaches(ctxt.getNumGlobalVarCaches());
+		fun->initCallSiteFeedback(ctxt.getNumCallSites());
 
 		if(ctxt.getUsesStaticVars())
 			fun->setStaticData(std::move(staticData));
@@ -116,24 +120,68 @@ void Compiler::addStatement(FnCompileContext & ctxt,EPtr<AST::ASTNode> statement
 }
 
 
+/*! (internal) Combine the instructions at @p pos into a single instruction accessing a local variable directly:
+		getLocalVariable $x; dup; getAttribute id	->	getLocalAndAttribute $x.id
+		getLocalVariable $x; getAttribute id		->	getLocalAttribute $x.id
+		dup; assignLocal $x; pop					->	assignLocal $x
+	Returns the number of replaced instructions (0 if the instructions can't be combined).
+	\note A jump target is marked by a setMarker-instruction, so a sequence is never entered in the middle. */
+static size_t combineInstructions(const std::vector<Instruction> & instructions,const size_t pos,Instruction & combined){
+	static const uint32_t MAX_COMBINED_LOCAL_VAR_IDX = 0xFFFFFE; // the index is stored in 24 bit
+	const size_t remaining = instructions.size()-pos;
+	const Instruction & first = instructions[pos];
+	if(first.getType()==Instruction::I_GET_LOCAL_VARIABLE && first.getValue_uint32()<=MAX_COMBINED_LOCAL_VAR_IDX){
+		if(remaining>=3 && instructions[pos+1].getType()==Instruction::I_DUP
+				&& instructions[pos+2].getType()==Instruction::I_GET_ATTRIBUTE){
+			combined = Instruction::createGetLocalAndAttribute(first.getValue_uint32(),instructions[pos+2].getValue_Identifier());
+			return 3;
+		}else if(remaining>=2 && instructions[pos+1].getType()==Instruction::I_GET_ATTRIBUTE){
+			combined = Instruction::createGetLocalAttribute(first.getValue_uint32(),instructions[pos+1].getValue_Identifier());
+			return 2;
+		}
+	}else if(first.getType()==Instruction::I_DUP && remaining>=3
+			&& instructions[pos+1].getType()==Instruction::I_ASSIGN_LOCAL && instructions[pos+2].getType()==Instruction::I_POP){
+		combined = instructions[pos+1];
+		return 3;
+	}
+	return 0;
+}
+
 //! (static)
 void Compiler::finalizeInstructions( InstructionBlock & instructionBlock ){
 
 	std::vector<Instruction> & instructions = instructionBlock._accessInstructions();
 
+	// the context of a function containing a yield statement may be referenced by a YieldIterator
+	// and must not be replaced -> no tail calls
+	if(std::any_of(instructions.begin(),instructions.end(),[](const Instruction & i){	return i.getType()==Instruction::I_YIELD;	})){
+		for(auto & instruction : instructions){
+			if(instruction.getType() == Instruction::I_TAIL_CALL){
+				instruction = Instruction::createCall(instruction.getValue_uint32Pair().first,instruction.getValue_uint32Pair().second);
+			}
+		}
+	}
+
 //	if(instructionBlock.hasJumpMarkers()){
 		std::map<uint32_t,uint32_t> markerToPosition;
 
-		{ // pass 1: remove setMarker-instructions and store position
+		{ // pass 1: remove setMarker-instructions, store position and combine instructions accessing local variables
 			std::vector<Instruction> tmp;
-			for(const auto & instruction : instructions) {
+			std::vector<int> lines;
+			for(size_t i = 0; i<instructions.size(); ++i) {
+				const Instruction & instruction = instructions[i];
 				if(instruction.getType() == Instruction::I_SET_MARKER) {
 					markerToPosition[instruction.getValue_uint32()] = tmp.size();
-				} else {
-					tmp.push_back(instruction);
+					continue;
 				}
+				Instruction combined(instruction);
+				const size_t numCombined = combineInstructions(instructions,i,combined);
+				tmp.push_back(combined);
+				lines.push_back(instructionBlock.getLine(i));
+				if(numCombined>1)
+					i += numCombined-1;
 			}
-			tmp.swap(instructions);
+			instructionBlock._setInstructions(std::move(tmp),lines);
 //			instructionBlock.clearMarkerNames();
 		}
 
@@ -150,12 +198,19 @@ void Compiler::finalizeInstructions( InstructionBlock & instructionBlock ){
 					if(markerId>=Instruction::JMP_TO_MARKER_OFFSET){
 						instruction.setValue_uint32(markerToPosition[markerId]);
 					}
+				}else if( instruction.getType() == Instruction::I_ONCE_ENTER){
+					const std::pair<uint32_t,uint32_t> onceIdxAndMarkerId = instruction.getValue_uint32Pair();
+					if(onceIdxAndMarkerId.second>=Instruction::JMP_TO_MARKER_OFFSET){
+						instruction.setValue_uint32Pair(onceIdxAndMarkerId.first,markerToPosition[onceIdxAndMarkerId.second]);
+					}
 				}
 			}
 
 		}
+		instructionBlock.initSwitchTables();
 
 //	}
+	instructionBlock.finishConstantDeclarations();
 }
 
 void Compiler::throwError(FnCompileContext & ctxt,const std::string & msg)const{
@@ -169,6 +224,128 @@ void Compiler::throwError(FnCompileContext & ctxt,const std::string & msg)const{
 
 // ------------------------------------------------------------------
 
+/*! (internal) Create the instructions of a user function (parameter handling and body).
+	@p ctxt2 is the compile context of the function's instruction block.	*/
+static void compileUserFunctionBody(FnCompileContext & ctxt2,UserFunction & fun,AST::UserFunctionExpr * self){
+	ctxt2.setLine(self->getLine()); // set the line of all initializations to the line of the function declaration
+
+	// declare local variables
+	for(const auto & param : self->getParamList())
+		fun.getInstructionBlock().declareLocalVariable(param.getName());
+
+	ctxt2.pushSetting_basicLocalVars(); // make 'this' and parameters available
+
+	// default parameters
+	for(const auto & param : self->getParamList()) {
+		EPtr<AST::ASTNode> defaultExpr = param.getDefaultValueExpression();
+		if(defaultExpr){
+			const auto varLocation = ctxt2.getCurrentVarLocation(param.getName());
+			if(!isLocalVarLocation(varLocation))
+				ctxt2.getCompiler().throwError(ctxt2,"Assertion failed."); // should never happen
+			const int varIdx = varLocation.second;
+
+			const uint32_t parameterAvailableMarker = ctxt2.createMarker();
+			ctxt2.addInstruction(Instruction::createPushUInt(varIdx));
+			ctxt2.addInstruction(Instruction::createJmpIfSet(parameterAvailableMarker));
+
+//					ctxt2.enableGlobalVarContext();				// \todo !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+			ctxt2.addExpression(defaultExpr);
+//					ctxt2.disableGlobalVarContext();			// \todo !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+			ctxt2.addInstruction(Instruction::createAssignLocal(varIdx));
+
+			ctxt2.addInstruction(Instruction::createSetMarker(parameterAvailableMarker));
+		}
+	}
+
+	// parameter type checks
+	for(const auto & param : self->getParamList()) {
+		const AST::ASTNode::refArray_t & typeExpressions = param.getTypeExpressions();
+		if(typeExpressions.empty())
+			continue;
+		const auto varLocation = ctxt2.getCurrentVarLocation(param.getName());
+		if(!isLocalVarLocation(varLocation))
+			ctxt2.getCompiler().throwError(ctxt2,"Assertion failed."); // should never happen
+		const int varIdx = varLocation.second;
+		// if the parameter has value constrains AND is a multi parameter, use a special system-call for this (instead of manually creating a foreach-loop here)
+		// e.g. fn([Bool,Number] p*){...}
+		if(param.isMultiParam()){
+			for(const auto & typeExpr : typeExpressions) {
+				ctxt2.addExpression(typeExpr);
+			}
+			ctxt2.addInstruction(Instruction::createGetLocalVariable(varIdx));
+			ctxt2.addInstruction(Instruction::createSysCall(Consts::SYS_CALL_TEST_ARRAY_PARAMETER_CONSTRAINTS,typeExpressions.size()+1 ));
+			ctxt2.addInstruction(Instruction::createPop());
+
+		}else{
+			std::vector<uint32_t> constrainOkMarkers; // each constrain gets its own ok-marker
+			for(const auto & typeExpr : typeExpressions) {
+				const uint32_t constrainOkMarker = ctxt2.createMarker();
+				constrainOkMarkers.push_back(constrainOkMarker);
+				
+				ctxt2.addExpression(typeExpr); // the constraint remains on the stack for the error message
+				ctxt2.addInstruction(Instruction::createCheckConstraint(varIdx)); // constraint._checkConstraint( param )
+				ctxt2.addInstruction(Instruction::createJmpOnTrue(constrainOkMarker));
+			}
+
+			// all constraint-checks failed! -> stack contains all failed constraints
+			ctxt2.addInstruction(Instruction::createGetLocalVariable(varIdx));
+			ctxt2.addInstruction(Instruction::createSysCall(Consts::SYS_CALL_THROW_TYPE_EXCEPTION,constrainOkMarkers.size()+1 ));
+			ctxt2.addInstruction(Instruction::createJmp( Instruction::INVALID_JUMP_ADDRESS ));
+//
+			// depending on which constraint-check succeeded, pop the constraint-values from the stack
+			for(std::vector<uint32_t>::const_reverse_iterator cIt = constrainOkMarkers.rbegin();cIt!=constrainOkMarkers.rend();++cIt){
+				ctxt2.addInstruction(Instruction::createSetMarker(*cIt));
+				ctxt2.addInstruction(Instruction::createPop());
+			}
+		}
+	}
+
+	// add super-constructor parameters
+	const AST::ASTNode::refArray_t & superConstrParams = self->getSConstructorExpressions();
+	for(const auto & superConstrParam : superConstrParams) {
+		ctxt2.addExpression(superConstrParam);
+	}
+
+	// init 'this' (or create it if this is a constructor call)
+	ctxt2.addInstruction(Instruction::createInitCaller(superConstrParams.size()));
+
+	ctxt2.addStatement(self->getBlock());
+	ctxt2.popSetting();
+	Compiler::finalizeInstructions(fun.getInstructionBlock());
+	fun.initOnceStatements(ctxt2.getNumOnceStatements());
+	fun.initGlobalVariableCaches(ctxt2.getNumGlobalVarCaches());
+	fun.initCallSiteFeedback(ctxt2.getNumCallSites());
+	fun.initAccessor();
+	if(ctxt2.getUsesStaticVars()){
+		_CountedRef<StaticData> staticData = &ctxt2.getStaticData();
+		fun.setStaticData(std::move(staticData));
+	}
+}
+
+//! (internal) Creates the instructions of a nested function when the function is called for the first time.
+class LazyFunctionCompilation : public UserFunction::PendingCompilation{
+		Compiler compiler;
+		_CountedRef<StaticData> staticData;
+		ERef<AST::UserFunctionExpr> expression;
+		FnCompileContext::varLocationMap_t outerStaticVars;
+	public:
+		LazyFunctionCompilation(FnCompileContext & parentCtxt,AST::UserFunctionExpr * _expression) :
+				compiler(parentCtxt.getCompiler()),staticData(&parentCtxt.getStaticData()),expression(_expression),
+				outerStaticVars(parentCtxt.collectVisibleStaticVars()){}
+		virtual ~LazyFunctionCompilation(){}
+
+		void compile(UserFunction & fun) override{
+			FnCompileContext ctxt(compiler,*staticData.get(),fun.getInstructionBlock(),expression->getCode());
+			ctxt.setOuterStaticVars(outerStaticVars);
+			try{
+				compileUserFunctionBody(ctxt,fun,expression.get());
+			}catch(...){
+				fun.getInstructionBlock() = InstructionBlock(); // the compilation is repeated on the next call
+				throw;
+			}
+		}
+};
+
 
 //! (static)
 bool initHandler(handlerRegistry_t & m){
@@ -200,7 +377,7 @@ bool initHandler(handlerRegistry_t & m){
 	})
 	// Number
 	ADD_HANDLER( ASTNode::TYPE_VALUE_FLOATING_POINT, AST::NumberValueExpr, {
-		ctxt.addInstruction(Instruction::createPushNumber(self->getValue()));
+		ctxt.addInstruction(Instruction::createPushNumber(ctxt.declareNumber(self->getValue())));
 	})
 
 	// String
@@ -220,21 +397,17 @@ bool initHandler(handlerRegistry_t & m){
 		// once-annotation (the only valid annotation at the moment)=
 		const uint32_t skipMarker = ctxt.createMarker();
 		
-		const auto onceStatementId = ctxt.createOnceStatementMarkerId();
+		const uint32_t onceStatementIdx = ctxt.createOnceStatementIdx();
 	
-		ctxt.addInstruction(Instruction::createPushId( onceStatementId ));
-		ctxt.addInstruction(Instruction::createSysCall( Consts::SYS_CALL_ONCE_ENTER,0 )); // directly pops the id from the stack
-		ctxt.addInstruction(Instruction::createJmpOnTrue( skipMarker ));
+		ctxt.addInstruction(Instruction::createOnceEnter( onceStatementIdx, skipMarker )); // jumps to skipMarker if already executed
 		
-		ctxt.pushSetting_stringId( FnCompileContext::ONCE_STATEMENT_ID, onceStatementId);
+		ctxt.pushSetting_marker( FnCompileContext::ONCE_STATEMENT_ID, onceStatementIdx);
 		
 		//! TODO set exception handler
 		
 		ctxt.addStatement(self->getStatement());
 		
-		ctxt.addInstruction(Instruction::createPushId( onceStatementId ));
-		ctxt.addInstruction(Instruction::createSysCall( Consts::SYS_CALL_ONCE_LEAVE,0 )); // directly pops the id from the stack
-		ctxt.addInstruction(Instruction::createPop());
+		ctxt.addInstruction(Instruction::createOnceLeave( onceStatementIdx ));
 		
 		// apply ONCE setting
 		ctxt.popSetting();
@@ -259,11 +432,8 @@ bool initHandler(handlerRegistry_t & m){
 			ctxt.addInstruction(Instruction::createSetExceptionHandler(targetCatchMarker));
 		
 		// leave open @(once) statements
-		for(auto &onceStatementId : ctxt.collectStringIds(FnCompileContext::ONCE_STATEMENT_ID, FnCompileContext::BREAK_MARKER)){
-			ctxt.addInstruction(Instruction::createPushId( onceStatementId ));
-			ctxt.addInstruction(Instruction::createSysCall( Consts::SYS_CALL_ONCE_LEAVE,0 )); // directly pops the id from the stack
-			ctxt.addInstruction(Instruction::createPop());
-		}
+		for(const auto & onceStatementIdx : ctxt.collectMarkers(FnCompileContext::ONCE_STATEMENT_ID, FnCompileContext::BREAK_MARKER))
+			ctxt.addInstruction(Instruction::createOnceLeave( onceStatementIdx ));
 					
 		ctxt.addInstruction(Instruction::createJmp(target));
 	})
@@ -360,11 +530,8 @@ bool initHandler(handlerRegistry_t & m){
 			ctxt.addInstruction(Instruction::createSetExceptionHandler(targetCatchMarker));
 		
 		// leave open @(once) statements
-		for(auto &onceStatementId : ctxt.collectStringIds(FnCompileContext::ONCE_STATEMENT_ID, FnCompileContext::CONTINUE_MARKER)){
-			ctxt.addInstruction(Instruction::createPushId( onceStatementId ));
-			ctxt.addInstruction(Instruction::createSysCall( Consts::SYS_CALL_ONCE_LEAVE,0 )); // directly pops the id from the stack
-			ctxt.addInstruction(Instruction::createPop());
-		}
+		for(const auto & onceStatementIdx : ctxt.collectMarkers(FnCompileContext::ONCE_STATEMENT_ID, FnCompileContext::CONTINUE_MARKER))
+			ctxt.addInstruction(Instruction::createOnceLeave( onceStatementIdx ));
 
 		ctxt.addInstruction(Instruction::createJmp(target));
 	})
@@ -397,15 +564,14 @@ bool initHandler(handlerRegistry_t & m){
 								ctxt.addInstruction(Instruction::createGetLocalVariable(varLocation.second));
 							}else{ // static var
 								ctxt.markAsUsingStaticVars();
-								ctxt.addInstruction(Instruction::createPushUInt(varLocation.second));
-								ctxt.addInstruction(Instruction::createSysCall(Consts::SYS_CALL_GET_STATIC_VAR,0));
+								ctxt.addInstruction(Instruction::createGetStaticVariable(varLocation.second));
 							}
 
 						}else{
 							if( self->isConstructorCall() ){ // constructor calls don't need a caller
-								ctxt.addInstruction(Instruction::createGetVariable(attrId));
+								ctxt.addInstruction(Instruction::createGetVariable(attrId,ctxt.createGlobalVarCacheIdx()));
 							}else{
-								ctxt.addInstruction(Instruction::createFindVariable(attrId));
+								ctxt.addInstruction(Instruction::createFindVariable(attrId,ctxt.createGlobalVarCacheIdx()));
 							}
 						}
 						break;
@@ -466,8 +632,10 @@ bool initHandler(handlerRegistry_t & m){
 			ctxt.addInstruction(Instruction::createSysCall(self->getSysCallId(),paramCount));
 		}else if( self->isConstructorCall()){
 			ctxt.addInstruction(Instruction::createCreateInstance(paramCount));
+		}else if( ctxt.isTailCallExpression(self) ){ // return f(...)
+			ctxt.addInstruction(Instruction::createTailCall(paramCount,ctxt.createCallSiteIdx()));
 		}else{
-			ctxt.addInstruction(Instruction::createCall(paramCount));
+			ctxt.addInstruction(Instruction::createCall(paramCount,ctxt.createCallSiteIdx()));
 		}
 	})
 
@@ -482,10 +650,9 @@ bool initHandler(handlerRegistry_t & m){
 				ctxt.addInstruction(Instruction::createGetLocalVariable(varLocation.second));
 			}else if(isStaticVarLocation(varLocation)){ // static var
 				ctxt.markAsUsingStaticVars();
-				ctxt.addInstruction(Instruction::createPushUInt(varLocation.second));
-				ctxt.addInstruction(Instruction::createSysCall(Consts::SYS_CALL_GET_STATIC_VAR,0));
+				ctxt.addInstruction(Instruction::createGetStaticVariable(varLocation.second));
 			}else{
-				ctxt.addInstruction(Instruction::createGetVariable(self->getAttrId()));
+				ctxt.addInstruction(Instruction::createGetVariable(self->getAttrId(),ctxt.createGlobalVarCacheIdx()));
 			}
 		}
 
@@ -605,14 +772,15 @@ bool initHandler(handlerRegistry_t & m){
 	// ReturnStatement
 	ADD_HANDLER( ASTNode::TYPE_RETURN_STATEMENT, ReturnStatement, {
 		if(self->getValueExpression()){
+			// return f(...) -> tail call; not possible if @(once) statements have to be left after the call
+			if(self->getValueExpression()->getNodeType()==ASTNode::TYPE_FUNCTION_CALL_EXPRESSION
+					&& ctxt.collectMarkers(FnCompileContext::ONCE_STATEMENT_ID).empty())
+				ctxt.markAsTailCallExpression(self->getValueExpression().get());
 			ctxt.addExpression(self->getValueExpression());
 			ctxt.addInstruction(Instruction::createAssignLocal(Consts::LOCAL_VAR_INDEX_internalResult));
 		}
-		for(auto &onceStatementId : ctxt.collectStringIds(FnCompileContext::ONCE_STATEMENT_ID)){ // jumping out of @(once) statements
-			ctxt.addInstruction(Instruction::createPushId( onceStatementId ));
-			ctxt.addInstruction(Instruction::createSysCall( Consts::SYS_CALL_ONCE_LEAVE,0 )); // directly pops the id from the stack
-			ctxt.addInstruction(Instruction::createPop());
-		}
+		for(const auto & onceStatementIdx : ctxt.collectMarkers(FnCompileContext::ONCE_STATEMENT_ID)) // jumping out of @(once) statements
+			ctxt.addInstruction(Instruction::createOnceLeave( onceStatementIdx ));
 		
 		ctxt.addInstruction(Instruction::createJmp(Instruction::INVALID_JUMP_ADDRESS));
 	})
@@ -633,9 +801,7 @@ bool initHandler(handlerRegistry_t & m){
 					ctxt.addInstruction(Instruction::createAssignLocal(varLocation.second));
 				}else if(isStaticVarLocation(varLocation)){
 					ctxt.markAsUsingStaticVars();
-					ctxt.addInstruction(Instruction::createPushUInt(varLocation.second));
-					ctxt.addInstruction(Instruction::createSysCall(Consts::SYS_CALL_SET_STATIC_VAR,0));
-					ctxt.addInstruction(Instruction::createPop());
+					ctxt.addInstruction(Instruction::createAssignStaticVariable(varLocation.second));
 				}else{ // obj attr or global var
 					ctxt.addInstruction(Instruction::createAssignVariable(attrId));
 				}
@@ -662,6 +828,28 @@ bool initHandler(handlerRegistry_t & m){
 		if(block->hasDeclaredVars())
 			ctxt.pushSetting_declaredVars(block->getVars());
 
+		// switches over enough constants of the same kind dispatch with a jump table; the following
+		// comparisons are only executed if the decision value's type does not match the constants' type.
+		static const size_t MIN_CASES_FOR_JUMP_TABLE = 4;
+		{
+			ASTNode::nodeType_t constantsType = ASTNode::TYPE_VALUE_VOID;
+			size_t numCases = 0;
+			for(const auto & posAndExpression: self->getCaseInfos()){
+				if(!posAndExpression.second) // default:
+					continue;
+				const ASTNode::nodeType_t type = posAndExpression.second->getNodeType();
+				if( (type!=ASTNode::TYPE_VALUE_FLOATING_POINT && type!=ASTNode::TYPE_VALUE_STRING && type!=ASTNode::TYPE_VALUE_IDENTIFIER)
+						|| (numCases>0 && type!=constantsType)){
+					numCases = 0;
+					break;
+				}
+				constantsType = type;
+				++numCases;
+			}
+			if(numCases>=MIN_CASES_FOR_JUMP_TABLE)
+				ctxt.addInstruction(Instruction::createSwitch(static_cast<uint32_t>(numCases)));
+		}
+
 		// add comparisons
 		auto defaultMarker = endMarker;
 		caseMarkerQueue_t caseMarkers; // stmtIndex -> marker
@@ -796,9 +984,6 @@ bool initHandler(handlerRegistry_t & m){
 		fun->setCode(self->getCode());
 		fun->setLine(self->getLine());
 
-		FnCompileContext ctxt2(ctxt,fun->getInstructionBlock(),self->getCode());
-		ctxt2.setLine(self->getLine()); // set the line of all initializations to the line of the function declaration
-
 		{	// init parameter counts
 			int minParamValueCount = 0;
 			for(const auto & param : self->getParamList()) {
@@ -822,97 +1007,13 @@ bool initHandler(handlerRegistry_t & m){
 			fun->setParameterCounts(self->getParamList().size(),minParamValueCount,maxParamValueCount);
 		}
 
-		// declare local variables
-		for(const auto & param : self->getParamList())
-			fun->getInstructionBlock().declareLocalVariable(param.getName());
-
-		ctxt2.pushSetting_basicLocalVars(); // make 'this' and parameters available
-
-		// default parameters
-		for(const auto & param : self->getParamList()) {
-			EPtr<AST::ASTNode> defaultExpr = param.getDefaultValueExpression();
-			if(defaultExpr){
-				const auto varLocation = ctxt2.getCurrentVarLocation(param.getName());
-				if(!isLocalVarLocation(varLocation))
-					ctxt.getCompiler().throwError(ctxt,"Assertion failed."); // should never happen
-				const int varIdx = varLocation.second;
-
-				const uint32_t parameterAvailableMarker = ctxt2.createMarker();
-				ctxt2.addInstruction(Instruction::createPushUInt(varIdx));
-				ctxt2.addInstruction(Instruction::createJmpIfSet(parameterAvailableMarker));
-
-//					ctxt2.enableGlobalVarContext();				// \todo !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-				ctxt2.addExpression(defaultExpr);
-//					ctxt2.disableGlobalVarContext();			// \todo !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-				ctxt2.addInstruction(Instruction::createAssignLocal(varIdx));
-
-				ctxt2.addInstruction(Instruction::createSetMarker(parameterAvailableMarker));
-			}
-		}
-
-		// parameter type checks
-		for(const auto & param : self->getParamList()) {
-			const ASTNode::refArray_t & typeExpressions = param.getTypeExpressions();
-			if(typeExpressions.empty())
-				continue;
-			const auto varLocation = ctxt2.getCurrentVarLocation(param.getName());
-			if(!isLocalVarLocation(varLocation))
-				ctxt.getCompiler().throwError(ctxt,"Assertion failed."); // should never happen
-			const int varIdx = varLocation.second;
-			// if the parameter has value constrains AND is a multi parameter, use a special system-call for this (instead of manually creating a foreach-loop here)
-			// e.g. fn([Bool,Number] p*){...}
-			if(param.isMultiParam()){
-				for(const auto & typeExpr : typeExpressions) {
-					ctxt2.addExpression(typeExpr);
-				}
-				ctxt2.addInstruction(Instruction::createGetLocalVariable(varIdx));
-				ctxt2.addInstruction(Instruction::createSysCall(Consts::SYS_CALL_TEST_ARRAY_PARAMETER_CONSTRAINTS,typeExpressions.size()+1 ));
-				ctxt2.addInstruction(Instruction::createPop());
-
-			}else{
-				std::vector<uint32_t> constrainOkMarkers; // each constrain gets its own ok-marker
-				for(const auto & typeExpr : typeExpressions) {
-					const uint32_t constrainOkMarker = ctxt2.createMarker();
-					constrainOkMarkers.push_back(constrainOkMarker);
-					
-					ctxt2.addExpression(typeExpr); // caller
-					ctxt2.addInstruction(Instruction::createDup()); // store the constraint for the error message
-					
-					ctxt2.addInstruction(Instruction::createDup());
-					ctxt2.addInstruction(Instruction::createGetAttribute(Consts::IDENTIFIER_fn_checkConstraint));	// fun
-									ctxt2.addInstruction(Instruction::createGetLocalVariable(varIdx)); // param
-					ctxt2.addInstruction( Instruction::createCall(1) ); // caller.fun ( param)
-					ctxt2.addInstruction(Instruction::createJmpOnTrue(constrainOkMarker));
-				}
-
-				// all constraint-checks failed! -> stack contains all failed constraints
-				ctxt2.addInstruction(Instruction::createGetLocalVariable(varIdx));
-				ctxt2.addInstruction(Instruction::createSysCall(Consts::SYS_CALL_THROW_TYPE_EXCEPTION,constrainOkMarkers.size()+1 ));
-				ctxt2.addInstruction(Instruction::createJmp( Instruction::INVALID_JUMP_ADDRESS ));
-//
-				// depending on which constraint-check succeeded, pop the constraint-values from the stack
-				for(std::vector<uint32_t>::const_reverse_iterator cIt = constrainOkMarkers.rbegin();cIt!=constrainOkMarkers.rend();++cIt){
-					ctxt2.addInstruction(Instruction::createSetMarker(*cIt));
-					ctxt2.addInstruction(Instruction::createPop());
-				}
-			}
-		}
-
-		// add super-constructor parameters
-		const ASTNode::refArray_t & superConstrParams = self->getSConstructorExpressions();
-		for(const auto & superConstrParam : superConstrParams) {
-			ctxt2.addExpression(superConstrParam);
-		}
-
-		// init 'this' (or create it if this is a constructor call)
-		ctxt2.addInstruction(Instruction::createInitCaller(superConstrParams.size()));
-
-		ctxt2.addStatement(self->getBlock());
-		ctxt2.popSetting();
-		Compiler::finalizeInstructions(fun->getInstructionBlock());
-		if(ctxt2.getUsesStaticVars()){
-			_CountedRef<StaticData> staticData = &ctxt.getStaticData();
-			fun->setStaticData(std::move(staticData));
+		// The body is compiled when the function is called for the first time, unless the declaration of
+		// static variables has to be done now (the static data container must not grow while being used).
+		if(self->declaresStaticVars()){
+			FnCompileContext ctxt2(ctxt,fun->getInstructionBlock(),self->getCode());
+			compileUserFunctionBody(ctxt2,*fun.get(),self);
+		}else{
+			fun->setPendingCompilation(new LazyFunctionCompilation(ctxt,self));
 		}
 
 		ctxt.addInstruction(Instruction::createPushFunction(ctxt.registerInternalFunction(fun.get())));
@@ -9,7 +9,6 @@
 #include "FnCompileContext.h"
 #include "Compiler.h"
 #include "../Objects/Callables/UserFunction.h" // StaticData
-#include <sstream>
 
 namespace EScript{
 
@@ -20,12 +19,6 @@ void FnCompileContext::addStatement(EPtr<AST::ASTNode> stmt){
 	compiler.addStatement(*this,stmt);
 }
 
-StringId FnCompileContext::createOnceStatementMarkerId(){
-	std::ostringstream s;
-	s << "___once_"<<currentOnceMarkerCounter++;
-	return s.str();
-}
-
 uint32_t FnCompileContext::getCurrentMarker(setting_t type)const{
 	for(std::vector<SettingsStackEntry>::const_reverse_iterator it = settingsStack.rbegin(); it!=settingsStack.rend(); ++it){
 		const SettingsStackEntry & entry = *it;
@@ -35,16 +28,16 @@ uint32_t FnCompileContext::getCurrentMarker(setting_t type)const{
 	return Instruction::INVALID_JUMP_ADDRESS;
 }
 
-std::vector<StringId> FnCompileContext::collectStringIds(setting_t type, setting_t untilMarkerType)const{
-	std::vector<StringId> theIds;
+std::vector<uint32_t> FnCompileContext::collectMarkers(setting_t type, setting_t untilMarkerType)const{
+	std::vector<uint32_t> theMarkers;
 	for(std::vector<SettingsStackEntry>::const_reverse_iterator it = settingsStack.rbegin(); it!=settingsStack.rend(); ++it){
 		const SettingsStackEntry & entry = *it;
 		if(entry.type == type)
-			theIds.push_back(entry.stringId);
+			theMarkers.push_back(entry.marker);
 		if(entry.type == untilMarkerType)
 			break;
 	}
-	return theIds;
+	return theMarkers;
 }
 
 void FnCompileContext::pushSetting_basicLocalVars(){
@@ -98,9 +91,31 @@ varLocation_t FnCompileContext::getCurrentVarLocation(const StringId & name)cons
 			}
 		}
 	}
+	for(const FnCompileContext *ctxt=this;ctxt;ctxt=ctxt->parent){
+		const auto fIt = ctxt->outerStaticVars.find(name);
+		if(fIt!=ctxt->outerStaticVars.end())
+			return fIt->second;
+	}
 	return std::make_pair(variableType_t::LOCAL_VAR,-1); // invalid var
 }
 
+FnCompileContext::varLocationMap_t FnCompileContext::collectVisibleStaticVars()const{
+	varLocationMap_t staticVars;
+	for(const FnCompileContext *ctxt=this;ctxt;ctxt=ctxt->parent){
+		for(auto it = ctxt->settingsStack.rbegin();it!=ctxt->settingsStack.rend();++it){
+			if( (*it).type == VISIBLE_LOCAL_AND_STATIC_VARIABLES){
+				for(const auto & var_idAndLocation : (*it).declaredVariables) {
+					if(isStaticVarLocation(var_idAndLocation.second))
+						staticVars.emplace(var_idAndLocation); // the innermost declaration is visible
+				}
+			}
+		}
+	}
+	for(const FnCompileContext *ctxt=this;ctxt;ctxt=ctxt->parent)
+		staticVars.insert(ctxt->outerStaticVars.begin(),ctxt->outerStaticVars.end());
+	return staticVars;
+}
+
 std::vector<size_t> FnCompileContext::collectLocalVariables(setting_t entryType){
 	std::vector<size_t> variableIndices;
 	for(std::vector<SettingsStackEntry>::const_reverse_iterator it = settingsStack.rbegin();it!=settingsStack.rend();++it){
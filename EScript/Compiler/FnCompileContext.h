@@ -33,8 +33,9 @@ class FnCompileContext {
 		StaticData & staticData;
 		InstructionBlock & instructions;
 
-		typedef std::unordered_map<StringId,varLocation_t> varLocationMap_t;
 	public:
+		typedef std::unordered_map<StringId,varLocation_t> varLocationMap_t;
+
 		enum setting_t{
 			VISIBLE_LOCAL_AND_STATIC_VARIABLES, //!< the local variables declared in a Block
 			BREAK_MARKER,
@@ -50,11 +51,9 @@ class FnCompileContext {
 			setting_t type;
 			uint32_t marker;
 			varLocationMap_t declaredVariables; // VISIBLE_LOCAL_AND_STATIC_VARIABLES
-			StringId stringId;	// ONCE_STATEMENT_ID
 
 			SettingsStackEntry(setting_t _type = VISIBLE_LOCAL_AND_STATIC_VARIABLES) : type(_type),marker(Instruction::INVALID_JUMP_ADDRESS){}
 			SettingsStackEntry(setting_t _type,uint32_t _marker) : type(_type),marker(_marker){}
-			SettingsStackEntry(setting_t _type,StringId _stringId) : type(_type),stringId(_stringId){}
 
 		};
 
@@ -65,21 +64,25 @@ class FnCompileContext {
 
 		int currentLine;
 		uint32_t currentMarkerId;
-		uint32_t currentOnceMarkerCounter; // used for @(once) [statement]
+		uint32_t currentOnceStatementIdx; // used for @(once) [statement]
+		uint32_t currentGlobalVarCacheIdx; // used for accessing non-local variables
+		uint32_t currentCallSiteIdx; // used for the type feedback of calls
 
 		CodeFragment code;
 		FnCompileContext* parent; // used for detecting the visibility of static variables
+		varLocationMap_t outerStaticVars; // static variables of the surrounding functions of a lazily compiled function
 		bool usesStaticVars; // if true, the function has to reference the static data container
+		const AST::ASTNode * tailCallExpression; // call expression of a 'return f(...)' statement
 	public:
 		FnCompileContext(Compiler & _compiler,StaticData&sData, InstructionBlock & _instructions,const CodeFragment & _code) :
 				compiler(_compiler),staticData(sData),instructions(_instructions),currentLine(-1),currentMarkerId(Instruction::JMP_TO_MARKER_OFFSET),
-				currentOnceMarkerCounter(0),code(_code),parent(nullptr),usesStaticVars(false){}
+				currentOnceStatementIdx(0),currentGlobalVarCacheIdx(0),currentCallSiteIdx(0),code(_code),parent(nullptr),usesStaticVars(false),tailCallExpression(nullptr){}
 
 		// create a context for a function embedded another function
 		FnCompileContext(FnCompileContext& parentCtxt,InstructionBlock & _instructions,const CodeFragment & _code) :
 				compiler(parentCtxt.compiler),staticData(parentCtxt.staticData),
 				instructions(_instructions),currentLine(-1),currentMarkerId(Instruction::JMP_TO_MARKER_OFFSET),
-				currentOnceMarkerCounter(0),code(_code),parent(&parentCtxt),usesStaticVars(false){}
+				currentOnceStatementIdx(0),currentGlobalVarCacheIdx(0),currentCallSiteIdx(0),code(_code),parent(&parentCtxt),usesStaticVars(false),tailCallExpression(nullptr){}
 
 		void addInstruction(const Instruction & newInstruction)			{	instructions.addInstruction(newInstruction,currentLine);	}
 
@@ -91,8 +94,12 @@ class FnCompileContext {
 		void addStatement(EPtr<AST::ASTNode> stmt);
 
 		uint32_t createMarker()											{	return currentMarkerId++;	}
-		StringId createOnceStatementMarkerId(); // used for @(once) [statement]
+		uint32_t createOnceStatementIdx()								{	return currentOnceStatementIdx++;	} // used for @(once) [statement]
+		uint32_t createGlobalVarCacheIdx()								{	return currentGlobalVarCacheIdx++;	} // used for accessing non-local variables
+		//! Returns Instruction::NO_CALL_SITE_FEEDBACK if the index can't be stored in a call instruction.
+		uint32_t createCallSiteIdx()									{	return currentCallSiteIdx<0xFFFFFE ? currentCallSiteIdx++ : Instruction::NO_CALL_SITE_FEEDBACK;	}
 		uint32_t declareString(const std::string & str)					{	return instructions.declareString(str);	}
+		uint32_t declareNumber(const double value)						{	return instructions.declareNumber(value);	}
 
 		const CodeFragment & getCode()const								{	return code;	}
 		Compiler & getCompiler()const									{	return compiler;	}
@@ -100,28 +107,38 @@ class FnCompileContext {
 		int getCurrentLine()const										{	return currentLine;	}
 		//! if the setting is not defined, Instruction::INVALID_JUMP_ADDRESS is returned.
 		uint32_t getCurrentMarker(setting_t markerType)const;
-		std::vector<StringId> collectStringIds(setting_t markerType, setting_t untilMarkerType=INVALID)const;
+		//! Collect all markers of the given type on the settings stack until an entry with the untilMarkerType is found.
+		std::vector<uint32_t> collectMarkers(setting_t markerType, setting_t untilMarkerType=INVALID)const;
 		
 		//! First search the settings stack for the next underMarkerType setting, then find the the next targetMarkerType setting.
 		//! If no marker could be found, Instruction::INVALID_JUMP_ADDRESS is returned.
 		uint32_t getMarkerUnderOtherMarker(setting_t targetMarkerType, setting_t underMarkerType);
 
 		varLocation_t getCurrentVarLocation(const StringId & name)const;
-
+		//! Collect the static variables visible for a function declared at the current position.
+		varLocationMap_t collectVisibleStaticVars()const;
+		//! Make the static variables of the surrounding functions visible (used when compiling a function lazily).
+		void setOuterStaticVars(const varLocationMap_t & vars)			{	outerStaticVars = vars;	}
+
+		uint32_t getNumOnceStatements()const							{	return currentOnceStatementIdx;	}
+		uint32_t getNumGlobalVarCaches()const							{	return currentGlobalVarCacheIdx;	}
+		uint32_t getNumCallSites()const									{	return currentCallSiteIdx;	}
 		std::string getInstructionsAsString()const						{	return instructions.toString();	}
 		StringId getLocalVarName(const size_t index)const				{	return instructions.getLocalVarName(index);	}
 
 		size_t getNumLocalVars()const									{	return instructions.getNumLocalVars();	}
-		std::string getStringConstant(const uint32_t index)const		{	return instructions.getStringConstant(index);	}
+		const StringData & getStringConstant(const uint32_t index)const	{	return instructions.getStringConstant(index);	}
 		bool getUsesStaticVars()const									{	return usesStaticVars;	}
+		bool isTailCallExpression(const AST::ASTNode * expression)const	{	return expression==tailCallExpression;	}
 
 		void markAsUsingStaticVars()									{	usesStaticVars = true;	}
+		//! The given call expression is the value of a return statement and may be compiled as tail call.
+		void markAsTailCallExpression(const AST::ASTNode * expression)	{	tailCallExpression = expression;	}
 
 		//! Add the local variables which are already defined in the instructionBlock (e.g. 'this' or the parameters), to the set of visible variables.
 		void pushSetting_basicLocalVars();
 
 		void pushSetting_marker(setting_t type, const uint32_t marker)	{	settingsStack.push_back(SettingsStackEntry(type,marker));	}
-		void pushSetting_stringId(setting_t type, StringId id)			{	settingsStack.push_back(SettingsStackEntry(type,id));	}
 
 		void pushSetting_declaredVars(const declaredVariableMap_t & variables);
 		void popSetting()												{	settingsStack.pop_back();	}
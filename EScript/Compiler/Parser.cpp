@@ -29,6 +29,7 @@
 
 #include <cstdio>
 #include <iostream>
+#include <set>
 #include <stack>
 #include <sstream>
 
@@ -58,8 +59,11 @@ struct ParsingContext{
 	std::deque<AST::Block*> blocks; // used as a stack
 	CodeFragment code;
 	Logger& logger;
+	std::set<size_t> functionsDeclaringStaticVars; // starting positions of the functions whose bodies declare static variables
+	size_t numEnclosingLoops; // loops around the current statement inside of the current function
+	size_t numEnclosingSwitches; // switch statements around the current statement inside of the current function
 	ParsingContext(Tokenizer::tokenList_t & _tokens,const CodeFragment & _code,Logger& _logger ) : 
-		tokens(_tokens),rootBlock(nullptr),code(_code),logger(_logger){}
+		tokens(_tokens),rootBlock(nullptr),code(_code),logger(_logger),numEnclosingLoops(0),numEnclosingSwitches(0){}
 };
 
 //---------------------------------------------------------------
@@ -498,6 +502,8 @@ void pass_2(ParsingContext & ctxt,
 	/// Counts the currently open brackets and blocks for the current function declaration.
 	/// If the top value reaches 0 after reading a TEndBlock, the fn-wrapper brackets have to be closed.
 	std::stack<int> functionBracketDepth;
+	/// Starting positions of the currently open function declarations.
+	std::vector<size_t> functionStartingPositions;
 
 	std::stack<TStartBracket*> currentBracket;
 
@@ -539,6 +545,8 @@ void pass_2(ParsingContext & ctxt,
 						if(!blockStack.top()->declareStaticVar(ti->getId())){
 							log(ctxt,Logger::LOG_WARNING, "Duplicate static variable '"+ti->toString()+'\'',ti);
 						}
+						for(const auto & pos : functionStartingPositions)
+							ctxt.functionsDeclaringStaticVars.insert(pos);
 					} else
 						throwError(ctxt,"static expects identifier.",tc);
 				}
@@ -593,6 +601,7 @@ void pass_2(ParsingContext & ctxt,
 
 					if(functionBracketDepth.top()==0){
 						functionBracketDepth.pop();
+						functionStartingPositions.pop_back();
 						Token * t = new TEndBracket;
 						t->setLine(line);
 						enrichedTokens.push_back(t);
@@ -657,6 +666,7 @@ void pass_2(ParsingContext & ctxt,
 			case TOperator::TYPE_ID:{
 				if( token->toString() == "fn"  ) {
 					functionBracketDepth.push(0);
+					functionStartingPositions.push_back(token->getStartingPos());
 
 					// bracket before 'fn'
 					TStartBracket * t = new TStartBracket;
@@ -1415,8 +1425,13 @@ EPtr<AST::ASTNode> readFunctionDeclaration(ParsingContext & ctxt,int & cursor){
 
 
 	ctxt.blocks.push_back(nullptr); // mark beginning of new local namespace
+	const size_t outerLoops = ctxt.numEnclosingLoops;
+	const size_t outerSwitches = ctxt.numEnclosingSwitches;
+	ctxt.numEnclosingLoops = ctxt.numEnclosingSwitches = 0; // 'break' and 'continue' can't leave the function
 	Block * block = readBlockExpression(ctxt,cursor);
 	block->convertToStatement();
+	ctxt.numEnclosingLoops = outerLoops;
+	ctxt.numEnclosingSwitches = outerSwitches;
 	ctxt.blocks.pop_back(); // remove marking for local namespace
 
 	const size_t codeEndPos = tokens.at(cursor)->getStartingPos(); // position of '}'
@@ -1427,6 +1442,8 @@ EPtr<AST::ASTNode> readFunctionDeclaration(ParsingContext & ctxt,int & cursor){
 	{	// create function expression
 		UserFunctionExpr * uFunExpr = new UserFunctionExpr(block,superConCallExpressions,line);
 		uFunExpr->emplaceParameterExpressions(std::move(params));	// set parameter expressions
+		if(ctxt.functionsDeclaringStaticVars.count(codeStartPos)>0)
+			uFunExpr->markAsDeclaringStaticVars();
 
 		// store code segment in userFunction
 		if(codeStartPos!=std::string::npos && codeEndPos!=std::string::npos && !ctxt.code.empty()){
@@ -1526,7 +1543,9 @@ EPtr<AST::ASTNode> readControl(ParsingContext & ctxt,int & cursor){
 			throwError(ctxt,"[for] expects )",tokens.at(cursor));
 		}
 		++cursor;
+		++ctxt.numEnclosingLoops;
 		EPtr<AST::ASTNode> action = readStatement(ctxt,cursor);
+		--ctxt.numEnclosingLoops;
 
 		EPtr<AST::ASTNode> elseAction;
 		if((tc = Token::cast<TControl>(tokens.at(cursor+1))) && tc->getId()==Consts::IDENTIFIER_else) {
@@ -1563,7 +1582,9 @@ EPtr<AST::ASTNode> readControl(ParsingContext & ctxt,int & cursor){
 			throwError(ctxt,"[while] expects (...)",tokens.at(cursor));
 		}
 		++cursor;
+		++ctxt.numEnclosingLoops;
 		EPtr<AST::ASTNode> action = readStatement(ctxt,cursor);
+		--ctxt.numEnclosingLoops;
 		EPtr<AST::ASTNode> elseAction;
 		if((tc = Token::cast<TControl>(tokens.at(cursor+1))) && tc->getId()==Consts::IDENTIFIER_else) {
 			++cursor;
@@ -1586,7 +1607,9 @@ EPtr<AST::ASTNode> readControl(ParsingContext & ctxt,int & cursor){
 		} break:
 	*/
 	else if(cId==Consts::IDENTIFIER_do) {
+		++ctxt.numEnclosingLoops;
 		EPtr<AST::ASTNode> action = readStatement(ctxt,cursor);
+		--ctxt.numEnclosingLoops;
 		++cursor;
 		tc = Token::cast<TControl>(tokens.at(cursor));
 		if(!tc || tc->getId()!=Consts::IDENTIFIER_while)
@@ -1675,7 +1698,9 @@ EPtr<AST::ASTNode> readControl(ParsingContext & ctxt,int & cursor){
 		if(!Token::isA<TEndBlock>(tokens.at(cursor)))
 			throwError(ctxt,"[foreach] expects )",tokens.at(cursor));
 		++cursor;
+		++ctxt.numEnclosingLoops;
 		EPtr<AST::ASTNode> action = readStatement(ctxt,cursor);
+		--ctxt.numEnclosingLoops;
 
 		EPtr<AST::ASTNode> elseAction;
 		if((tc = Token::cast<TControl>(tokens.at(cursor+1))) && tc->getId()==Consts::IDENTIFIER_else) {
@@ -1768,6 +1793,7 @@ EPtr<AST::ASTNode> readControl(ParsingContext & ctxt,int & cursor){
 		std::vector<std::pair<size_t,ERef<AST::ASTNode>>> caseDescriptions;
 
 		bool defaultCaseRead = false;
+		++ctxt.numEnclosingSwitches;
 		/// Read commands.
 		while(!Token::isA<TEndBlock>(tokens.at(cursor))) {
 			if(Token::isA<TEndScript>(tokens.at(cursor)))
@@ -1813,6 +1839,7 @@ EPtr<AST::ASTNode> readControl(ParsingContext & ctxt,int & cursor){
 			assertTokenIsStatemetEnding(ctxt,tokens.at(cursor).get());
 			++cursor;
 		}
+		--ctxt.numEnclosingSwitches;
 		if(!defaultCaseRead){
 			caseDescriptions.emplace_back(block->getStatements().size(),nullptr);
 		}
@@ -1864,11 +1891,16 @@ EPtr<AST::ASTNode> readControl(ParsingContext & ctxt,int & cursor){
 		return new TryCatchStatement(tryBlock,catchBlock,varName);
 	}
 	/// continue-Control
+	// \note nested functions are compiled on their first call, so their misplaced 'continue' and 'break' statements are reported here
 	else if(cId==Consts::IDENTIFIER_continue) {
+		if(ctxt.numEnclosingLoops==0)
+			throwError(ctxt,"'continue' outside a loop.",tc);
 		return new ContinueStatement;
 	}
 	/// break-Control
 	else if(cId==Consts::IDENTIFIER_break) {
+		if(ctxt.numEnclosingLoops==0 && ctxt.numEnclosingSwitches==0)
+			throwError(ctxt,"'break' outside a loop.",tc);
 		return new BreakStatement;
 	}
 	/// return-Control
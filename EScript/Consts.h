@@ -92,11 +92,7 @@ struct Consts{
 	static const size_t SYS_CALL_TEST_ARRAY_PARAMETER_CONSTRAINTS = 6;
 	static const size_t SYS_CALL_EXPAND_PARAMS_ON_STACK = 7;
 	static const size_t SYS_CALL_CASE_TEST = 8;
-	static const size_t SYS_CALL_ONCE_ENTER = 9;
-	static const size_t SYS_CALL_ONCE_LEAVE = 10;
-	static const size_t SYS_CALL_GET_STATIC_VAR = 11;
-	static const size_t SYS_CALL_SET_STATIC_VAR = 12;
-	static const size_t NUM_SYS_CALLS = 13;
+	static const size_t NUM_SYS_CALLS = 9;
 
 	static const uint32_t DYNAMIC_PARAMETER_COUNT = ~0u;
 };
@@ -10,9 +10,19 @@
 #include "InstructionBlock.h"
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 
 namespace EScript {
 
+static_assert(sizeof(Instruction)==8,"Instructions should be encoded in 8 bytes.");
+
+void Instruction::setValue_uint32Pair(uint32_t v1,uint32_t v2){
+	if(v2>=VALUE2_MAX && v2!=~0u)
+		throw std::overflow_error("Instruction: value exceeds 24 bit.");
+	value = v1;
+	value2 = v2==~0u ? VALUE2_MAX : v2;
+}
+
 //! (static)
 Instruction Instruction::createAssignAttribute(const StringId & varName){
 	Instruction i(I_ASSIGN_ATTRIBUTE);
@@ -27,6 +37,13 @@ Instruction Instruction::createAssignLocal(const uint32_t localVarIdx){
 	return i;
 }
 
+//! (static)
+Instruction Instruction::createAssignStaticVariable(const uint32_t staticVarIdx){
+	Instruction i(I_ASSIGN_STATIC_VARIABLE);
+	i.setValue_uint32(staticVarIdx);
+	return i;
+}
+
 //! (static)
 Instruction Instruction::createAssignVariable(const StringId & varName){
 	Instruction i(I_ASSIGN_VARIABLE);
@@ -36,9 +53,16 @@ Instruction Instruction::createAssignVariable(const StringId & varName){
 
 
 //! (static)
-Instruction Instruction::createCall(const uint32_t numParams){
+Instruction Instruction::createCall(const uint32_t numParams,const uint32_t callSiteIdx){
 	Instruction i(I_CALL);
-	i.setValue_uint32(numParams);
+	i.setValue_uint32Pair(numParams,callSiteIdx);
+	return i;
+}
+
+//! (static)
+Instruction Instruction::createCheckConstraint(const uint32_t localVarIdx){
+	Instruction i(I_CHECK_CONSTRAINT);
+	i.setValue_uint32(localVarIdx);
 	return i;
 }
 
@@ -50,9 +74,9 @@ Instruction Instruction::createCreateInstance(const uint32_t numParams){
 }
 
 //! (static)
-Instruction Instruction::createFindVariable(const StringId & id){
+Instruction Instruction::createFindVariable(const StringId & id,const uint32_t globalVarCacheIdx){
 	Instruction i(I_FIND_VARIABLE);
-	i.setValue_Identifier(id);
+	i.setValue_uint32Pair(id.getValue(),globalVarCacheIdx);
 	return i;
 }
 
@@ -63,6 +87,20 @@ Instruction Instruction::createGetAttribute(const StringId & id){
 	return i;
 }
 
+//! (static)
+Instruction Instruction::createGetLocalAndAttribute(const uint32_t localVarIdx,const StringId & id){
+	Instruction i(I_GET_LOCAL_AND_ATTRIBUTE);
+	i.setValue_uint32Pair(id.getValue(),localVarIdx);
+	return i;
+}
+
+//! (static)
+Instruction Instruction::createGetLocalAttribute(const uint32_t localVarIdx,const StringId & id){
+	Instruction i(I_GET_LOCAL_ATTRIBUTE);
+	i.setValue_uint32Pair(id.getValue(),localVarIdx);
+	return i;
+}
+
 //! (static)
 Instruction Instruction::createGetLocalVariable(const uint32_t localVarIdx){
 	Instruction i(I_GET_LOCAL_VARIABLE);
@@ -71,9 +109,16 @@ Instruction Instruction::createGetLocalVariable(const uint32_t localVarIdx){
 }
 
 //! (static)
-Instruction Instruction::createGetVariable(const StringId & id){
+Instruction Instruction::createGetStaticVariable(const uint32_t staticVarIdx){
+	Instruction i(I_GET_STATIC_VARIABLE);
+	i.setValue_uint32(staticVarIdx);
+	return i;
+}
+
+//! (static)
+Instruction Instruction::createGetVariable(const StringId & id,const uint32_t globalVarCacheIdx){
 	Instruction i(I_GET_VARIABLE);
-	i.setValue_Identifier(id);
+	i.setValue_uint32Pair(id.getValue(),globalVarCacheIdx);
 	return i;
 }
 
@@ -111,6 +156,19 @@ Instruction Instruction::createJmpOnFalse(const uint32_t markerId){
 	return i;
 }
 
+//! (static)
+Instruction Instruction::createOnceEnter(const uint32_t onceStatementIdx,const uint32_t skipMarkerId){
+	Instruction i(I_ONCE_ENTER);
+	i.setValue_uint32Pair(onceStatementIdx,skipMarkerId);
+	return i;
+}
+
+//! (static)
+Instruction Instruction::createOnceLeave(const uint32_t onceStatementIdx){
+	Instruction i(I_ONCE_LEAVE);
+	i.setValue_uint32(onceStatementIdx);
+	return i;
+}
 
 //! (static)
 Instruction Instruction::createPushBool(const bool value){
@@ -134,9 +192,9 @@ Instruction Instruction::createPushFunction(const uint32_t functionIndex){
 }
 
 //! (static)
-Instruction Instruction::createPushNumber(const double value){
+Instruction Instruction::createPushNumber(const uint32_t numberIndex){
 	Instruction i(I_PUSH_NUMBER);
-	i.setValue_Number(value);
+	i.setValue_uint32(numberIndex);
 	return i;
 }
 
@@ -179,6 +237,13 @@ Instruction Instruction::createSetMarker(const uint32_t markerId){
 	return i;
 }
 
+//! (static)
+Instruction Instruction::createSwitch(const uint32_t numCases){
+	Instruction i(I_SWITCH);
+	i.setValue_uint32Pair(numCases,0); // the table index is set by InstructionBlock::initSwitchTables()
+	return i;
+}
+
 //! (static)
 Instruction Instruction::createSysCall(const uint32_t fnIdx, const uint32_t numParams){
 	Instruction i(I_SYS_CALL);
@@ -186,6 +251,13 @@ Instruction Instruction::createSysCall(const uint32_t fnIdx, const uint32_t numP
 	return i;
 }
 
+//! (static)
+Instruction Instruction::createTailCall(const uint32_t numParams,const uint32_t callSiteIdx){
+	Instruction i(I_TAIL_CALL);
+	i.setValue_uint32Pair(numParams,callSiteIdx);
+	return i;
+}
+
 std::string Instruction::toString(const InstructionBlock & ctxt)const{
 	std::ostringstream out;
 	switch(type){
@@ -197,6 +269,10 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 		out << "assignLocal $" << getValue_uint32() <<" // '" << ctxt.getLocalVarName(getValue_uint32()).toString()<<"'";
 		break;
 	}
+	case I_ASSIGN_STATIC_VARIABLE:{
+		out << "assignStaticVariable $" << getValue_uint32();
+		break;
+	}
 	case I_ASSIGN_VARIABLE:{
 		out << "assignVariable '" << getValue_Identifier().toString() << "'";
 		break;
@@ -205,6 +281,10 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 		out << "call (numParams) " << getValue_uint32();
 		break;
 	}
+	case I_CHECK_CONSTRAINT:{
+		out << "checkConstraint $" << getValue_uint32() <<" // '" << ctxt.getLocalVarName(getValue_uint32()).toString()<<"'";
+		break;
+	}
 	case I_CREATE_INSTANCE:{
 		out << "createInstance (numParams) " << getValue_uint32();
 		break;
@@ -214,19 +294,35 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 		break;
 	}
 	case I_FIND_VARIABLE:{
-		out << "findVariable '" << getValue_Identifier().toString() << "'";
+		out << "findVariable '" << StringId(getValue_uint32Pair().first).toString() << "'";
 		break;
 	}
 	case I_GET_ATTRIBUTE:{
 		out << "getAttribute '" << getValue_Identifier().toString() << "'";
 		break;
 	}
+	case I_GET_LOCAL_AND_ATTRIBUTE:{
+		const uint32_t localVarIdx = getValue_uint32Pair().second;
+		out << "getLocalAndAttribute $" << localVarIdx << "." << StringId(getValue_uint32Pair().first).toString()
+				<< " // '" << ctxt.getLocalVarName(localVarIdx).toString()<<"'";
+		break;
+	}
+	case I_GET_LOCAL_ATTRIBUTE:{
+		const uint32_t localVarIdx = getValue_uint32Pair().second;
+		out << "getLocalAttribute $" << localVarIdx << "." << StringId(getValue_uint32Pair().first).toString()
+				<< " // '" << ctxt.getLocalVarName(localVarIdx).toString()<<"'";
+		break;
+	}
 	case I_GET_LOCAL_VARIABLE:{
 		out << "getLocalVariable $" << getValue_uint32()<<" // '" << ctxt.getLocalVarName(getValue_uint32()).toString()<<"'";
 		break;
 	}
+	case I_GET_STATIC_VARIABLE:{
+		out << "getStaticVariable $" << getValue_uint32();
+		break;
+	}
 	case I_GET_VARIABLE:{
-		out << "getVariable '" << getValue_Identifier().toString() << "'";
+		out << "getVariable '" << StringId(getValue_uint32Pair().first).toString() << "'";
 		break;
 	}
 	case I_INIT_CALLER:{
@@ -269,6 +365,19 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 		out << "not";
 		break;
 	}
+	case I_ONCE_ENTER:{
+		const std::pair<uint32_t,uint32_t> v = getValue_uint32Pair();
+		out << "onceEnter #" << v.first << " ";
+		if( v.second<JMP_TO_MARKER_OFFSET)
+			out << "-> "<<v.second;
+		else
+			out << "MARKER_" << v.second-JMP_TO_MARKER_OFFSET<< ":";
+		break;
+	}
+	case I_ONCE_LEAVE:{
+		out << "onceLeave #" << getValue_uint32();
+		break;
+	}
 	case I_POP:{
 		out << "pop";
 		break;
@@ -286,11 +395,11 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 		break;
 	}
 	case I_PUSH_NUMBER:{
-		out << "push (Number) " << getValue_Number();
+		out << "push (Number) #"<<getValue_uint32()<<" // " << ctxt.getNumberConstant(getValue_uint32());
 		break;
 	}
 	case I_PUSH_STRING:{
-		out << "push (String) #"<<getValue_uint32()<<" // \"" << ctxt.getStringConstant(getValue_uint32())  << "\"";
+		out << "push (String) #"<<getValue_uint32()<<" // \"" << ctxt.getStringConstant(getValue_uint32()).str()  << "\"";
 		break;
 	}
 	case I_PUSH_UINT:{
@@ -329,11 +438,20 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 
 		break;
 	}
+	case I_SWITCH:{
+		const std::pair<uint32_t,uint32_t> v = getValue_uint32Pair();
+		out << "switch (numCases) " << v.first << ", table #" << v.second;
+		break;
+	}
 	case I_SYS_CALL:{
 		const std::pair<uint32_t,uint32_t> v = getValue_uint32Pair();
 		out << "sysCall (uint32_t,uint32_t) #"<<v.first<<", numParams: " << v.second;
 		break;
 	}
+	case I_TAIL_CALL:{
+		out << "tailCall (numParams) " << getValue_uint32();
+		break;
+	}
 	case I_YIELD:{
 		out << "yield";
 		break;
@@ -345,7 +463,6 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 			break;
 
 	}
-	out<<" (line "<<line<<")";
 	return out.str();
 }
 }
@@ -12,6 +12,8 @@
 #include "../Utils/StringId.h"
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <utility>
 
 namespace EScript {
 
@@ -24,20 +26,27 @@ class Instruction {
 		enum type_t{
 			I_ASSIGN_ATTRIBUTE,				// -2
 			I_ASSIGN_LOCAL,					// -1
+			I_ASSIGN_STATIC_VARIABLE,		// -1
 			I_ASSIGN_VARIABLE,				// -1
 			I_CALL,							// -2+x +1
+			I_CHECK_CONSTRAINT,				// +1
 			I_CREATE_INSTANCE,				// -1+x +1
 			I_DUP,							// +1
 			I_FIND_VARIABLE,				// +2
 			I_GET_ATTRIBUTE,				// -1 +1
 			I_GET_VARIABLE,					// +1
+			I_GET_LOCAL_AND_ATTRIBUTE,		// +2
+			I_GET_LOCAL_ATTRIBUTE,			// +1
 			I_GET_LOCAL_VARIABLE,			// +1
+			I_GET_STATIC_VARIABLE,			// +1
 			I_INIT_CALLER,					// -x +0
 			I_JMP,							// +-0
 			I_JMP_IF_SET,					// -1
 			I_JMP_ON_TRUE,					// -1
 			I_JMP_ON_FALSE,					// -1
 			I_NOT,							// -1 +1
+			I_ONCE_ENTER,					// +-0
+			I_ONCE_LEAVE,					// +-0
 			I_POP,							// -1
 			I_PUSH_BOOL,					// +1
 			I_PUSH_ID,						// +1
@@ -50,54 +59,64 @@ class Instruction {
 			I_RESET_LOCAL_VARIABLE,			// -x
 			I_SET_ATTRIBUTE,				// -3
 			I_SET_EXCEPTION_HANDLER,		// +-0
+			I_SWITCH,						// -1 (on success) or +-0
 			I_SYS_CALL,						// +-?
+			I_TAIL_CALL,					// -2+x +1
 			I_YIELD,						// -1
 			I_UNDEFINED,
 			I_SET_MARKER					// +-0
 		};
 		static const uint32_t JMP_TO_MARKER_OFFSET = 0x100000; //! if a jump target is >= JMP_TO_MARKER_OFFSET, the target is a marker and not an address.
 		static const uint32_t INVALID_JUMP_ADDRESS = 0x0FFFFF; //! A jump to this address always ends the current function. \todo assure that no IntructionBlock can have so many Instructions
+		static const uint32_t NO_CALL_SITE_FEEDBACK = ~0u; //! Call instruction without a feedback slot in its UserFunction.
 
 		std::string toString(const InstructionBlock & ctxt)const;
 
-		type_t getType()const						{	return type;	}
+		type_t getType()const						{	return static_cast<type_t>(type);	}
 
-		uint32_t getValue_uint32()const				{	return data.value_uint32;	}
-		void setValue_uint32(const uint32_t v)		{	data.value_uint32 = v;	}
+		uint32_t getValue_uint32()const				{	return value;	}
+		void setValue_uint32(const uint32_t v)		{	value = v;	}
 
-		double getValue_Number()const				{	return data.value_number;	}
-		void setValue_Number(double v)				{	data.value_number = v;	}
+		StringId getValue_Identifier()const			{	return StringId(value);	}
+		void setValue_Identifier(StringId v)		{	value = v.getValue();	}
 
-		StringId getValue_Identifier()const			{	return StringId(data.value_identifier);	}
-		void setValue_Identifier(StringId v)		{	data.value_identifier = v.getValue();	}
+		bool getValue_Bool()const					{	return value!=0;	}
+		void setValue_Bool(bool v)					{	value = v ? 1 : 0;	}
 
-		bool getValue_Bool()const					{	return data.value_bool;	}
-		void setValue_Bool(bool v)					{	data.value_bool = v;	}
-
-		std::pair<uint32_t,uint32_t> getValue_uint32Pair()const	{	return data.value_uint32Pair;	}
-		void setValue_uint32Pair(uint32_t v1,uint32_t v2)	{	data.value_uint32Pair = std::make_pair(v1,v2);	}
+		//! \note The second value is limited to 24 bit (~0u is preserved).
+		std::pair<uint32_t,uint32_t> getValue_uint32Pair()const	{
+			return std::make_pair(value, value2==VALUE2_MAX ? ~0u : static_cast<uint32_t>(value2));
+		}
+		void setValue_uint32Pair(uint32_t v1,uint32_t v2);
 
 		static Instruction createAssignAttribute(const StringId & varName);
 		static Instruction createAssignLocal(const uint32_t localVarIdx);
+		static Instruction createAssignStaticVariable(const uint32_t staticVarIdx);
 		static Instruction createAssignVariable(const StringId & varName);
-		static Instruction createCall(const uint32_t numParams);
+		static Instruction createCall(const uint32_t numParams,const uint32_t callSiteIdx = NO_CALL_SITE_FEEDBACK);
+		static Instruction createCheckConstraint(const uint32_t localVarIdx);
 		static Instruction createCreateInstance(const uint32_t numParams);
 		static Instruction createDup()				{	return Instruction(I_DUP);	}
-		static Instruction createFindVariable(const StringId & id);
+		static Instruction createFindVariable(const StringId & id,const uint32_t globalVarCacheIdx);
 		static Instruction createGetAttribute(const StringId & id);
+		static Instruction createGetLocalAndAttribute(const uint32_t localVarIdx,const StringId & id);
+		static Instruction createGetLocalAttribute(const uint32_t localVarIdx,const StringId & id);
 		static Instruction createGetLocalVariable(const uint32_t localVarIdx);
-		static Instruction createGetVariable(const StringId & id);
+		static Instruction createGetStaticVariable(const uint32_t staticVarIdx);
+		static Instruction createGetVariable(const StringId & id,const uint32_t globalVarCacheIdx);
 		static Instruction createInitCaller(const uint32_t numSuperParams);
 		static Instruction createJmp(const uint32_t markerId);
 		static Instruction createJmpIfSet(const uint32_t markerId);
 		static Instruction createJmpOnTrue(const uint32_t markerId);
 		static Instruction createJmpOnFalse(const uint32_t markerId);
 		static Instruction createNot()				{	return Instruction(I_NOT);	}
+		static Instruction createOnceEnter(const uint32_t onceStatementIdx,const uint32_t skipMarkerId);
+		static Instruction createOnceLeave(const uint32_t onceStatementIdx);
 		static Instruction createPop()				{	return Instruction(I_POP);	}
 		static Instruction createPushBool(const bool value);
 		static Instruction createPushId(const StringId & id);
 		static Instruction createPushFunction(const uint32_t functionIdx);
-		static Instruction createPushNumber(const double value);
+		static Instruction createPushNumber(const uint32_t numberIndex);
 		static Instruction createPushString(const uint32_t stringIndex);
 		static Instruction createPushUInt(const uint32_t value);
 		static Instruction createPushUndefined()	{	return Instruction(I_PUSH_UNDEFINED);	}
@@ -106,36 +125,30 @@ class Instruction {
 		static Instruction createSetAttribute(const StringId & id);
 		static Instruction createSetExceptionHandler(const uint32_t markerId);
 		static Instruction createSetMarker(const uint32_t markerId);
+		static Instruction createSwitch(const uint32_t numCases);
 		static Instruction createSysCall(const uint32_t fnIdx, const uint32_t numParams);
+		static Instruction createTailCall(const uint32_t numParams,const uint32_t callSiteIdx = NO_CALL_SITE_FEEDBACK);
 		static Instruction createYield()			{	return Instruction(I_YIELD);	}
 
-		int getLine()const			{	return line;	}
-		void setLine(const int l)	{	line = l;	}
+		//! (internal) Access to the instruction's value as raw data; used for storing compiled code.
+		uint64_t _getRawValue()const				{	return static_cast<uint64_t>(value) | (static_cast<uint64_t>(value2)<<32);	}
+		//! (static,internal)
+		static Instruction _createFromRawValue(type_t type,uint64_t rawValue){
+			Instruction i(type);
+			i.value = static_cast<uint32_t>(rawValue);
+			i.value2 = static_cast<uint32_t>(rawValue>>32) & VALUE2_MAX;
+			return i;
+		}
 
 	private:
-		Instruction( type_t _type) : type(_type),line(-1){}
-		type_t type;
-		union value_t{
-			double value_number;
-			size_t value_numParams;
-			uint32_t value_identifier;
-			uint32_t value_uint32;
-			bool value_bool;
-			std::pair<uint32_t,uint32_t> value_uint32Pair;
-			uint64_t raw;
-			value_t():raw(0){static_assert(sizeof(raw)==sizeof(value_t),"'raw' must cover the whole union.");}
-			value_t(value_t && other) : raw(other.raw) {}
-			value_t(const value_t & other) : raw(other.raw) {}
-			value_t & operator=(value_t && other) {
-				raw = other.raw;
-				return *this;
-			}
-			value_t & operator=(const value_t & other) {
-				raw = other.raw;
-				return *this;
-			}
-		}data;
-		int line;
+		/*! An instruction is encoded in 8 bytes: the type (8 bit), a second value (24 bit) and a
+			value (32 bit). Larger constants (Numbers, Strings) are stored in the InstructionBlock and
+			the line numbers in the InstructionBlock's line table. */
+		static const uint32_t VALUE2_MAX = 0xFFFFFF;
+		Instruction( type_t _type) : type(static_cast<uint32_t>(_type)),value2(0),value(0){}
+		uint32_t type : 8;
+		uint32_t value2 : 24;
+		uint32_t value;
 };
 }
 
@@ -9,6 +9,8 @@
 #include "InstructionBlock.h"
 #include "../Objects/Callables/UserFunction.h"
 #include "../Consts.h"
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 namespace EScript{
@@ -20,6 +22,21 @@ InstructionBlock::InstructionBlock() {
 	declareLocalVariable(Consts::IDENTIFIER_internalResult); // $2 : Consts::LOCAL_VAR_INDEX_internalResult
 }
 
+uint32_t InstructionBlock::declareNumber(const double value){
+	// compare the bit patterns, so that NaN is found and -0.0 is not merged with 0.0
+	uint64_t bits;
+	static_assert(sizeof(bits)==sizeof(value),"unexpected size of double");
+	std::memcpy(&bits,&value,sizeof(value));
+	const auto result = numberConstantIndices.emplace(bits,static_cast<uint32_t>(numberConstants.size()));
+	if(result.second)
+		numberConstants.push_back(value);
+	return result.first->second;
+}
+
+void InstructionBlock::finishConstantDeclarations(){
+	std::unordered_map<uint64_t,uint32_t>().swap(numberConstantIndices); // clear() would keep the buckets
+}
+
 StringId InstructionBlock::getLocalVarName(const size_t index)const{
 	if(index >= localVariables.size()) {
 		return StringId();
@@ -27,6 +44,76 @@ StringId InstructionBlock::getLocalVarName(const size_t index)const{
 	return localVariables.at(index);
 }
 
+const StringData & InstructionBlock::getStringConstant(const uint32_t index)const{
+	static const StringData emptyString;
+	return index<stringConstants.size() ? stringConstants[index] : emptyString;
+}
+
+int InstructionBlock::getLine(const size_t index)const{
+	if(index>=instructions.size())
+		return -1;
+	const auto it = std::upper_bound(lineTable.begin(),lineTable.end(),index,
+			[](const size_t i,const std::pair<uint32_t,int> & entry){	return i<entry.first;	});
+	return it==lineTable.begin() ? -1 : (it-1)->second;
+}
+
+void InstructionBlock::_setInstructions(std::vector<Instruction> && newInstructions,const std::vector<int> & lines){
+	instructions.clear();
+	lineTable.clear();
+	for(size_t i = 0; i<newInstructions.size(); ++i)
+		addInstruction(newInstructions[i], i<lines.size() ? lines[i] : -1);
+}
+
+void InstructionBlock::initSwitchTables(){
+	switchTables.clear();
+	for(size_t i = 0; i<instructions.size(); ++i){
+		if(instructions[i].getType()!=Instruction::I_SWITCH)
+			continue;
+		const uint32_t numCases = instructions[i].getValue_uint32Pair().first;
+		instructions[i].setValue_uint32Pair(numCases,static_cast<uint32_t>(switchTables.size()));
+		switchTables.emplace_back();
+		SwitchTable & table = switchTables.back();
+
+		const size_t chainEnd = i+1+3*static_cast<size_t>(numCases);
+		if(numCases==0 || chainEnd>=instructions.size() || instructions[chainEnd].getType()!=Instruction::I_POP)
+			continue;
+		SwitchTable::keyType_t keyType = SwitchTable::INVALID;
+		switch(instructions[i+1].getType()){
+			case Instruction::I_PUSH_NUMBER:	keyType = SwitchTable::NUMBER;		break;
+			case Instruction::I_PUSH_STRING:	keyType = SwitchTable::STRING;		break;
+			case Instruction::I_PUSH_ID:		keyType = SwitchTable::IDENTIFIER;	break;
+			default:
+				continue;
+		}
+		bool valid = true;
+		for(size_t c = i+1; valid && c<chainEnd; c+=3){
+			const Instruction & pushValue = instructions[c];
+			const Instruction & caseTest = instructions[c+1];
+			const Instruction & jmp = instructions[c+2];
+			valid = caseTest.getType()==Instruction::I_SYS_CALL
+					&& caseTest.getValue_uint32Pair().first==Consts::SYS_CALL_CASE_TEST && caseTest.getValue_uint32Pair().second==1
+					&& jmp.getType()==Instruction::I_JMP_ON_TRUE && jmp.getValue_uint32()<instructions.size();
+			if(!valid)
+				break;
+			// the first matching case wins
+			if(keyType==SwitchTable::NUMBER && pushValue.getType()==Instruction::I_PUSH_NUMBER){
+				table.numberTargets.emplace(getNumberConstant(pushValue.getValue_uint32()),jmp.getValue_uint32());
+			}else if(keyType==SwitchTable::STRING && pushValue.getType()==Instruction::I_PUSH_STRING
+					&& pushValue.getValue_uint32()<stringConstants.size()){
+				table.stringTargets.emplace(stringConstants[pushValue.getValue_uint32()].str(),jmp.getValue_uint32());
+			}else if(keyType==SwitchTable::IDENTIFIER && pushValue.getType()==Instruction::I_PUSH_ID){
+				table.identifierTargets.emplace(pushValue.getValue_Identifier(),jmp.getValue_uint32());
+			}else{
+				valid = false;
+			}
+		}
+		if(valid){
+			table.keyType = keyType;
+			table.missAddress = static_cast<uint32_t>(chainEnd);
+		}
+	}
+}
+
 UserFunction * InstructionBlock::getUserFunction(const uint32_t index)const{
 	if(index<=internalFunctions.size()){
 		return dynamic_cast<UserFunction*>(internalFunctions.at(index).get());
@@ -52,7 +139,17 @@ std::string InstructionBlock::toString()const{
 		out << "String constants:";
 		uint32_t i = 0;
 		for(const auto & stringConst : stringConstants) {
-			out << " #"<<i<<"(\"" << stringConst << "\")";
+			out << " #"<<i<<"(\"" << stringConst.str() << "\")";
+			++i;
+		}
+		out << "\n";
+	}
+
+	if(!numberConstants.empty()){
+		out << "Number constants:";
+		uint32_t i = 0;
+		for(const auto & numberConst : numberConstants) {
+			out << " #"<<i<<"(" << numberConst << ")";
 			++i;
 		}
 		out << "\n";
@@ -62,7 +159,8 @@ std::string InstructionBlock::toString()const{
 	{
 		uint32_t i = 0;
 		for(const auto & instruction : instructions) {
-			out << (i++) << "\t" << instruction.toString(*this) << "\n";
+			out << i << "\t" << instruction.toString(*this) << " (line "<<getLine(i)<<")\n";
+			++i;
 		}
 
 	}
@@ -72,6 +170,8 @@ std::string InstructionBlock::toString()const{
 			UserFunction * uFun = getUserFunction(i);
 			if(uFun){
 				out << "<Function #"<<i<<"\n";
+				if(!uFun->isCompiled())
+					out << "(not compiled yet)\n";
 				out << uFun->getInstructionBlock().toString();
 				out << "Function #"<<i<<">\n";
 			}
@@ -10,10 +10,12 @@
 #define INSTRUCTION_BLOCK_H
 
 #include "Instruction.h"
+#include "../Utils/StringData.h"
 #include "../Utils/StringId.h"
 #include "../Objects/Object.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace EScript {
@@ -21,18 +23,41 @@ class UserFunction;
 
 //! Collection of (assembler-)instructions and the corresponding data.
 class InstructionBlock {
+	public:
+		/*! Jump table of a switch instruction. It is derived from the case test chain following the
+			switch instruction, whose cases are all constants of the same kind:
+				switch (numCases)
+				( push (Number|String|Identifier) constant ; sysCall CASE_TEST ; jmpOnTrue caseAddress ) * numCases
+				pop ; ... (missAddress)	*/
+		struct SwitchTable{
+			enum keyType_t{
+				INVALID, NUMBER, STRING, IDENTIFIER
+			} keyType;
+			std::unordered_map<double,uint32_t> numberTargets;
+			std::unordered_map<std::string,uint32_t> stringTargets;
+			std::unordered_map<StringId,uint32_t> identifierTargets;
+			uint32_t missAddress;
+			SwitchTable() : keyType(INVALID),missAddress(0){}
+		};
+	private:
 		std::vector<StringId> localVariables;
-		std::vector<std::string> stringConstants;  //! \todo --> StringData
+		std::vector<StringData> stringConstants; //! shared by all String objects created from the constant
+		std::vector<double> numberConstants;
+		std::unordered_map<uint64_t,uint32_t> numberConstantIndices; //! bit pattern -> index in numberConstants (only during code generation)
 		std::vector<Instruction> instructions;
+		//! (index of the first instruction, line) for every sequence of instructions with the same line
+		std::vector<std::pair<uint32_t,int>> lineTable;
 		std::vector<ObjRef > internalFunctions; //! UserFunction
+		std::vector<SwitchTable> switchTables;
 		// flags...
 	public:
 		InstructionBlock();
 
-		void addInstruction(const Instruction & newInstruction)	{	instructions.push_back(newInstruction);	}
+		void addInstruction(const Instruction & newInstruction)	{	addInstruction(newInstruction,-1);	}
 		void addInstruction(const Instruction & newInstruction,int line)	{
+			if(lineTable.empty() || lineTable.back().second!=line)
+				lineTable.emplace_back(static_cast<uint32_t>(instructions.size()),line);
 			instructions.push_back(newInstruction);
-			instructions.back().setLine(line);
 		}
 		uint32_t registerInternalFunction(const ObjPtr & userFunction)	{
 			internalFunctions.push_back(userFunction);
@@ -40,26 +65,44 @@ class InstructionBlock {
 		}
 
 		uint32_t declareString(const std::string & str){
-			stringConstants.push_back(str);
+			stringConstants.emplace_back(str);
+			stringConstants.back().initCodePointInfo(); // the data is only read afterwards (possibly by several threads)
 			return static_cast<uint32_t>(stringConstants.size()-1);
 		}
+		/*! Returns the index of the constant; constants with the same bit pattern share one entry
+			(only until finishConstantDeclarations() is called).	*/
+		uint32_t declareNumber(const double value);
+		//! (internal) Called when the code generation of the block is finished; frees the data used to merge constants.
+		void finishConstantDeclarations();
 		uint32_t declareLocalVariable(const StringId & name){
 			localVariables.push_back(name);
 			return static_cast<uint32_t>(localVariables.size()-1);
 		}
 		const Instruction & getInstruction(const size_t index)const	{	return instructions[index];	}
-		int getLine(const size_t index)const						{	return index<instructions.size() ? instructions[index].getLine() : -1;	}
+		//! Returns the line of the instruction with the given index or -1 if the line is unknown.
+		int getLine(const size_t index)const;
 
 
 		StringId getLocalVarName(const size_t index)const;
 		const std::vector<StringId> & getLocalVariables()const		{	return localVariables;	}
+		const std::vector<StringData> & getStringConstants()const	{	return stringConstants;	}
+		const std::vector<double> & getNumberConstants()const		{	return numberConstants;	}
+		const std::vector<ObjRef> & getInternalFunctions()const		{	return internalFunctions;	}
 
 		size_t getNumLocalVars()const								{	return localVariables.size();	}
 		size_t getNumInstructions()const							{	return instructions.size();	}
-		std::string getStringConstant(const uint32_t index)const	{	return index<=stringConstants.size() ? stringConstants[index] : "";	}
+		const StringData & getStringConstant(const uint32_t index)const;
+		double getNumberConstant(const uint32_t index)const			{	return index<numberConstants.size() ? numberConstants[index] : 0.0;	}
 		UserFunction * getUserFunction(const uint32_t index)const;
 
+		const SwitchTable & getSwitchTable(const uint32_t index)const	{	return switchTables[index];	}
+		/*! (internal) Create the jump tables for all switch instructions (after the jump addresses are final).
+			A table for a case test chain of unexpected form is marked as invalid.	*/
+		void initSwitchTables();
+
 		std::vector<Instruction> & _accessInstructions()			{	return instructions;	}
+		//! (internal) Replace all instructions; @p lines contains the line of each new instruction.
+		void _setInstructions(std::vector<Instruction> && newInstructions,const std::vector<int> & lines);
 		const std::vector<Instruction> & getInstructions()const		{	return instructions;	}
 
 		std::string toString()const;
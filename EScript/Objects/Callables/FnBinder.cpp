@@ -10,6 +10,8 @@
 
 #include "../../Basics.h"
 #include "../Collections/Array.h"
+#include "../../Utils/CycleCollector.h"
+#include "../../Utils/ObjectPool.h"
 
 namespace EScript{
 
@@ -20,25 +22,18 @@ Type * FnBinder::getTypeObject(){
 }
 
 //----
-static std::stack<FnBinder *> pool;
+typedef ObjectPool<FnBinder> FnBinderPool;
 
 FnBinder * FnBinder::create(ObjPtr object,ObjPtr function){
 	#ifdef ES_DEBUG_MEMORY
 	return new FnBinder(object,function);
 	#endif
-	if(pool.empty()){
-		for(int i = 0;i<32;++i){
-			pool.push(new FnBinder(nullptr,nullptr));
-		}
-		return create(object,function);
-	}else{
-		FnBinder * o = pool.top();
-		pool.pop();
-		o->myObjectRef = object;
-		o->functionRef = function;
-//        std::cout << ".";
-		return o;
-	}
+	FnBinder * o = FnBinderPool::getThreadLocalPool().pop();
+	if(!o)
+		return new FnBinder(object,function);
+	o->myObjectRef = object;
+	o->functionRef = function;
+	return o;
 }
 FnBinder * FnBinder::create(ObjPtr object,ObjPtr function,std::vector<ObjRef>&&params){
 	FnBinder* binder = create(object,function);
@@ -54,7 +49,8 @@ void FnBinder::release(FnBinder * o){
 	o->myObjectRef = nullptr;
 	o->functionRef = nullptr;
 	o->boundParameters.clear();
-	pool.push(o);
+	if(!FnBinderPool::getThreadLocalPool().push(o))
+		delete o;
 }
 
 //! initMembers
@@ -99,7 +95,7 @@ void FnBinder::init(EScript::Namespace & globals) {
 //! (ctor)
 FnBinder::FnBinder(ObjPtr object,ObjPtr function):
 		Object(getTypeObject()),myObjectRef(object.get()),functionRef(function.get()) {
-	//ctor
+	CycleCollector::registerObject(this);
 }
 
 
@@ -118,4 +114,25 @@ bool FnBinder::rt_isEqual(Runtime &,const ObjPtr & o){
 std::string FnBinder::toDbgString()const {
 	return std::string('('+myObjectRef.toString("?")+"->"+(functionRef.isNull() ? "?" : functionRef->toDbgString())+')');
 }
+
+//! ---|> [Object]
+void FnBinder::_traverseReferences(const std::function<void(Object*)> & visit)const{
+	Object::_traverseReferences(visit);
+	visit(myObjectRef.get());
+	visit(functionRef.get());
+	for(const auto & param : boundParameters)
+		visit(param.get());
+}
+
+//! ---|> [Object]
+void FnBinder::_releaseReferences(){
+	myObjectRef = nullptr;
+	functionRef = nullptr;
+	boundParameters.clear();
+}
+
+//! ---|> [Object]
+size_t FnBinder::_getMemoryUsage()const{
+	return sizeof(FnBinder) + boundParameters.capacity()*sizeof(ObjRef);
+}
 }
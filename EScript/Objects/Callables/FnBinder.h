@@ -29,7 +29,7 @@ class FnBinder : public Object {
 
 		Object * getObject()const				{	return myObjectRef.get();	}
 		Object * getFunction()const				{	return functionRef.get();	}
-		std::vector<ObjRef> getBoundParameters()const	{	return boundParameters;	}
+		const std::vector<ObjRef> & getBoundParameters()const	{	return boundParameters;	}
 		void setObject(ObjPtr newObject)		{	myObjectRef = newObject;		}
 		void setFunction(ObjPtr newFunction)	{	functionRef = newFunction;	}
 
@@ -38,6 +38,12 @@ class FnBinder : public Object {
 		bool rt_isEqual(Runtime &rt, const ObjPtr & o) override;
 		std::string toDbgString()const override;
 		internalTypeId_t _getInternalTypeId()const override	{	return _TypeIds::TYPE_FN_BINDER;	}
+		//! ---|> [Object]
+		void _traverseReferences(const std::function<void(Object*)> & visit)const override;
+		//! ---|> [Object]
+		void _releaseReferences() override;
+		//! ---|> [Object]
+		size_t _getMemoryUsage()const override;
 	private:
 		FnBinder(ObjPtr object,ObjPtr function);
 
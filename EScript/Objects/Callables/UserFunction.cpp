@@ -8,6 +8,7 @@
 // ---------------------------------------------------------------------------------
 #include "UserFunction.h"
 #include "../../Basics.h"
+#include "../../Consts.h"
 #include <sstream>
 
 namespace EScript{
@@ -50,10 +51,16 @@ void UserFunction::init(EScript::Namespace & globals) {
 	ES_MFUN(typeObject,UserFunction,"getParamCount",0,0, static_cast<uint32_t>(thisObj->getParamCount()))
 
 	//! [ESMF] Bool UserFunction.usesStaticData()
-	ES_MFUN(typeObject,UserFunction,"usesStaticData",0,0, thisObj->getStaticData()!=nullptr)
+	ES_MFUNCTION(typeObject,UserFunction,"usesStaticData",0,0,{
+		thisObj->compile();
+		return thisObj->getStaticData()!=nullptr;
+	})
 
 	//! [ESMF] String UserFunction._asm()
-	ES_MFUN(typeObject,UserFunction,"_asm",0,0, thisObj->getInstructionBlock().toString())
+	ES_MFUNCTION(typeObject,UserFunction,"_asm",0,0,{
+		thisObj->compile();
+		return thisObj->getInstructionBlock().toString();
+	})
 
 }
 
@@ -62,16 +69,37 @@ UserFunction::UserFunction(const UserFunction & other) :
 		ExtObject(other),codeFragment(other.codeFragment),line(other.line),
 		paramCount(other.paramCount),minParamValueCount(other.minParamValueCount),maxParamValueCount(other.maxParamValueCount),
 		multiParam(other.multiParam),instructions(other.instructions),
-		staticData(other.staticData){
+		staticData(other.staticData),pendingCompilation(other.pendingCompilation),compiled(other.isCompiled()),
+		accessorType(other.accessorType),accessorAttributeId(other.accessorAttributeId){
+	initOnceStatements(static_cast<uint32_t>(other.onceStates.size()));
+	for(size_t i = 0; i<onceStates.size(); ++i){ // a running statement is not finished in the copy
+	#if defined(ES_THREADING)
+		if(other.onceStates[i].state == ONCE_EXECUTED)
+			onceStates[i].state = ONCE_EXECUTED;
+	#else
+		if(other.onceStates[i] == ONCE_EXECUTED)
+			onceStates[i] = ONCE_EXECUTED;
+	#endif
+	}
+#if !defined(ES_THREADING)
+	initGlobalVariableCaches(static_cast<uint32_t>(other.globalVariableCaches.size()));
+	initCallSiteFeedback(static_cast<uint32_t>(other.callSiteFeedback.size()));
+#endif
 }
 
 //! (ctor)
 UserFunction::UserFunction() :
 		ExtObject(getTypeObject()),line(-1),paramCount(0),
-		minParamValueCount(0),maxParamValueCount(0),multiParam(-1) {
+		minParamValueCount(0),maxParamValueCount(0),multiParam(-1),compiled(true),accessorType(NO_ACCESSOR) {
 	//ctor
 }
 
+//! ---|> Object
+UserFunction * UserFunction::clone()const{
+	const_cast<UserFunction*>(this)->compile(); // the instructions are shared with the copy
+	return new UserFunction(*this);
+}
+
 //! ---|> Object
 std::string UserFunction::toDbgString()const{
 	std::ostringstream os;
@@ -86,4 +114,179 @@ std::string UserFunction::toDbgString()const{
 
 	return os.str();
 }
+
+//! ---|> Object
+void UserFunction::_traverseReferences(const std::function<void(Object*)> & visit)const{
+	ExtObject::_traverseReferences(visit);
+	// the static variables are only accounted to the function if they are not shared with other functions
+	if(staticData && staticData->countReferences()==1 && staticData->_isThreadConfined()){
+		for(const auto & value : staticData->getStaticVariableValues())
+			visit(value.get());
+	}
+}
+
+//! ---|> Object
+void UserFunction::_releaseReferences(){
+	ExtObject::_releaseReferences();
+	if(staticData && staticData->countReferences()==1 && staticData->_isThreadConfined()){
+		for(uint32_t i = 0; i<staticData->getStaticVariableValues().size(); ++i)
+			staticData->updateStaticVariable(i,nullptr);
+	}
+}
+
+//! ---|> Object
+size_t UserFunction::_getMemoryUsage()const{
+	return ExtObject::_getMemoryUsage() - sizeof(ExtObject) + sizeof(UserFunction) +
+			instructions.getInstructions().size()*sizeof(Instruction);
+}
+
+// -------------------------------------------------------------
+// @(once) statements
+
+void UserFunction::initOnceStatements(uint32_t numOnceStatements){
+	#if defined(ES_THREADING)
+	std::vector<OnceStatementState> states(numOnceStatements);
+	onceStates.swap(states);
+	#else
+	onceStates.assign(numOnceStatements, ONCE_NOT_EXECUTED);
+	#endif
+}
+
+bool UserFunction::enterOnceStatement(uint32_t onceStatementIdx){
+	#if defined(ES_THREADING)
+	auto & site = onceStates[onceStatementIdx];
+	if(site.state == ONCE_EXECUTED)
+		return false;
+	std::unique_lock<std::mutex> lock(site.mutex);
+	while(true){
+		if(site.state == ONCE_NOT_EXECUTED){
+			site.state = ONCE_RUNNING;
+			site.owner = std::this_thread::get_id();
+			return true;
+		}else if(site.state == ONCE_EXECUTED){
+			return false;
+		}else if(site.owner == std::this_thread::get_id()){ // (recursively) entered by its own execution -> skip it.
+			return false;
+		}
+		site.finished.wait(lock);
+	}
+	#else
+	auto & state = onceStates[onceStatementIdx];
+	// ONCE_RUNNING: the statement is (recursively) entered by its own execution -> skip it.
+	if(state != ONCE_NOT_EXECUTED)
+		return false;
+	state = ONCE_RUNNING;
+	return true;
+	#endif
+}
+
+void UserFunction::leaveOnceStatement(uint32_t onceStatementIdx){
+	#if defined(ES_THREADING)
+	auto & site = onceStates[onceStatementIdx];
+	{
+		std::lock_guard<std::mutex> lock(site.mutex);
+		site.state = ONCE_EXECUTED;
+	}
+	site.finished.notify_all();
+	#else
+	onceStates[onceStatementIdx] = ONCE_EXECUTED;
+	#endif
+}
+
+void UserFunction::abortOnceStatement(uint32_t onceStatementIdx){
+	#if defined(ES_THREADING)
+	auto & site = onceStates[onceStatementIdx];
+	{
+		std::lock_guard<std::mutex> lock(site.mutex);
+		site.state = ONCE_NOT_EXECUTED;
+	}
+	site.finished.notify_all(); // one of the waiting threads executes the statement
+	#else
+	onceStates[onceStatementIdx] = ONCE_NOT_EXECUTED;
+	#endif
+}
+
+// -------------------------------------------------------------
+// global variable caches
+
+void UserFunction::initGlobalVariableCaches(uint32_t numCaches){
+#if defined(ES_THREADING)
+	(void)numCaches; // the caches are not synchronized and therefore not used with threading support
+#else
+	globalVariableCaches.assign(numCaches,GlobalVariableCache());
+#endif
+}
+
+// -------------------------------------------------------------
+// lazy compilation
+
+#if defined(ES_THREADING)
+//! Lazy compilations are rare and short, so one mutex is shared.
+static std::mutex & getCompilationMutex(){
+	static std::mutex m;
+	return m;
+}
+#endif
+
+void UserFunction::setPendingCompilation(_CountedRef<PendingCompilation> && c){
+	pendingCompilation = std::move(c);
+	compiled = false;
+}
+
+void UserFunction::_compile(){
+	#if defined(ES_THREADING)
+	std::lock_guard<std::mutex> lock(getCompilationMutex());
+	if(compiled) // compiled by another thread in the meantime
+		return;
+	#endif
+	pendingCompilation->compile(*this); // on failure, the function remains uncompiled
+	pendingCompilation = nullptr;
+	compiled = true;
+}
+
+// -------------------------------------------------------------
+// accessor functions
+
+void UserFunction::initAccessor(){
+	accessorType = NO_ACCESSOR;
+	accessorAttributeId = StringId();
+	const std::vector<Instruction> & code = instructions.getInstructions();
+	if(getMultiParam()>=0 || getMinParamCount()!=static_cast<int>(getParamCount()) || getMaxParamCount()!=static_cast<int>(getParamCount())
+			|| code.empty() || code[0].getType()!=Instruction::I_INIT_CALLER || code[0].getValue_uint32()!=0)
+		return;
+	if(getParamCount()==0){
+		// initCaller 0; (getVariable id | getLocalAttribute $0.id); assignLocal $2; [jmp end]
+		if( (code.size()==3 || (code.size()==4 && code[3].getType()==Instruction::I_JMP && code[3].getValue_uint32()>=code.size()))
+				&& code[2].getType()==Instruction::I_ASSIGN_LOCAL && code[2].getValue_uint32()==Consts::LOCAL_VAR_INDEX_internalResult){
+			if(code[1].getType()==Instruction::I_GET_VARIABLE
+					|| (code[1].getType()==Instruction::I_GET_LOCAL_ATTRIBUTE && code[1].getValue_uint32Pair().second==Consts::LOCAL_VAR_INDEX_this)){
+				accessorType = ACCESSOR_GET;
+				accessorAttributeId = StringId(code[1].getValue_uint32Pair().first);
+			}
+		}
+	}else if(getParamCount()==1){
+		// initCaller 0; getLocalVariable $3; dup; getLocalVariable $0; assignAttribute id; pop
+		if(code.size()==6
+				&& code[1].getType()==Instruction::I_GET_LOCAL_VARIABLE && code[1].getValue_uint32()==Consts::LOCAL_VAR_INDEX_firstParameter
+				&& code[2].getType()==Instruction::I_DUP
+				&& code[3].getType()==Instruction::I_GET_LOCAL_VARIABLE && code[3].getValue_uint32()==Consts::LOCAL_VAR_INDEX_this
+				&& code[4].getType()==Instruction::I_ASSIGN_ATTRIBUTE
+				&& code[5].getType()==Instruction::I_POP){
+			accessorType = ACCESSOR_SET;
+			accessorAttributeId = code[4].getValue_Identifier();
+		}
+	}
+}
+
+// -------------------------------------------------------------
+// call site feedback
+
+void UserFunction::initCallSiteFeedback(uint32_t numCallSites){
+#if defined(ES_THREADING)
+	(void)numCallSites; // the feedback is not synchronized and therefore not used with threading support
+#else
+	callSiteFeedback.assign(numCallSites,CallSiteFeedback());
+#endif
+}
+
 }
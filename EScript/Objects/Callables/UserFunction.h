@@ -13,6 +13,12 @@
 #include "../../Instructions/InstructionBlock.h"
 #include "../../Utils/CodeFragment.h"
 #include <vector>
+#if defined(ES_THREADING)
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 namespace EScript {
 
@@ -84,8 +90,14 @@ class UserFunction : public ExtObject {
 
 		//! ---|> [Object]
 		internalTypeId_t _getInternalTypeId()const override	{	return _TypeIds::TYPE_USER_FUNCTION;	}
-		UserFunction * clone()const override				{	return new UserFunction(*this);	}
+		UserFunction * clone()const override;
 		std::string toDbgString()const override;
+		//! ---|> [Object]
+		void _traverseReferences(const std::function<void(Object*)> & visit)const override;
+		//! ---|> [Object]
+		void _releaseReferences() override;
+		//! ---|> [Object]
+		size_t _getMemoryUsage()const override;
 	private:
 		CodeFragment codeFragment;
 		int line;
@@ -96,6 +108,140 @@ class UserFunction : public ExtObject {
 		_CountedRef<StaticData> staticData;
 
 	//	@}
+
+	// -------------------------------------------------------------
+
+	//! @name Lazy compilation
+	//	@{
+	public:
+		/*! (internal) Deferred creation of the function's instructions. The Compiler creates the
+			instructions of a nested function when the function is executed for the first time.	*/
+		class PendingCompilation : public EReferenceCounter<PendingCompilation>{
+			public:
+				virtual ~PendingCompilation(){}
+				//! Create the instructions of the given function; a compiler error is thrown as Exception.
+				virtual void compile(UserFunction & fun) = 0;
+		};
+		//! (internal) Called by the Compiler instead of creating the instructions.
+		void setPendingCompilation(_CountedRef<PendingCompilation> && c);
+
+		bool isCompiled()const								{	return compiled;	}
+		//! Create the function's instructions if this has not been done yet.
+		void compile()										{	if(!compiled) _compile();	}
+	private:
+		void _compile();
+
+		_CountedRef<PendingCompilation> pendingCompilation;
+	#if defined(ES_THREADING)
+		std::atomic<bool> compiled;
+	#else
+		bool compiled;
+	#endif
+	//	@}
+
+	// -------------------------------------------------------------
+
+	//! @name Accessor functions
+	//	@{
+	public:
+		/*! Trivial accessor functions are executed by the Runtime without creating a FunctionCallContext.
+			ACCESSOR_GET:	fn(){	return attr;	}	or	fn(){	return this.attr;	}
+			ACCESSOR_SET:	fn(value){	this.attr = value;	}	*/
+		enum accessor_t : uint8_t{
+			NO_ACCESSOR, ACCESSOR_GET, ACCESSOR_SET
+		};
+		accessor_t getAccessorType()const					{	return accessorType;	}
+		StringId getAccessorAttributeId()const				{	return accessorAttributeId;	}
+
+		//! (internal) Detect if the function is a trivial accessor; called after the instructions have been finalized.
+		void initAccessor();
+	private:
+		accessor_t accessorType;
+		StringId accessorAttributeId;
+	//	@}
+
+	// -------------------------------------------------------------
+
+	//! @name @(once) statements
+	//	@{
+	public:
+		//! (internal) Called by the Compiler to create the states for the function's @(once) statements.
+		void initOnceStatements(uint32_t numOnceStatements);
+
+		/*! Returns true iff the @(once) statement with the given index has to be executed now.
+			A statement that is currently executed by the calling thread (recursive call) is skipped.
+			If the statement is currently executed by another thread, the call blocks until it is finished or aborted. */
+		bool enterOnceStatement(uint32_t onceStatementIdx);
+		//! Mark the @(once) statement as executed.
+		void leaveOnceStatement(uint32_t onceStatementIdx);
+		//! Mark the entered @(once) statement as not executed (its execution has been aborted by an exception).
+		void abortOnceStatement(uint32_t onceStatementIdx);
+	private:
+		enum onceState_t : uint8_t{
+			ONCE_NOT_EXECUTED, ONCE_RUNNING, ONCE_EXECUTED
+		};
+	#if defined(ES_THREADING)
+		struct OnceStatementState{
+			std::atomic<uint8_t> state;
+			std::thread::id owner;	//!< the thread executing the statement (protected by mutex)
+			std::mutex mutex;
+			std::condition_variable finished; //!< threads waiting for the running statement
+			OnceStatementState() : state(ONCE_NOT_EXECUTED){}
+		};
+		std::vector<OnceStatementState> onceStates;
+	#else
+		std::vector<uint8_t> onceStates;
+	#endif
+	//	@}
+
+	// -------------------------------------------------------------
+
+	//! @name Global variable caches
+	//	@{
+	public:
+		//! (internal) Called by the Compiler to create the caches for the function's non-local variable accesses.
+		void initGlobalVariableCaches(uint32_t numCaches);
+
+	#if !defined(ES_THREADING)
+		/*! (internal) Cached global variable of a getVariable/findVariable instruction.
+			The cell is the global variable's Attribute stored in the globals Namespace with the given serial number.
+			The guard states that the variable is no attribute of callers of the Type with the given serial number (as long as
+			Type::getLookupVersion() is unchanged) -- only the caller's local attributes have to be checked. */
+		struct GlobalVariableCache{
+			uint64_t namespaceSerialNumber;
+			Attribute * cell;
+			uint64_t callerTypeSerialNumber;
+			uint32_t lookupVersion;
+			GlobalVariableCache() : namespaceSerialNumber(0),cell(nullptr),callerTypeSerialNumber(0),lookupVersion(0){}
+		};
+		GlobalVariableCache & _accessGlobalVariableCache(uint32_t cacheIdx)	{	return globalVariableCaches[cacheIdx];	}
+	private:
+		std::vector<GlobalVariableCache> globalVariableCaches;
+	#endif // ES_THREADING
+	//	@}
+
+	// -------------------------------------------------------------
+
+	//! @name Call site feedback
+	//	@{
+	public:
+		//! (internal) Called by the Compiler to create the feedback slots for the function's call instructions.
+		void initCallSiteFeedback(uint32_t numCallSites);
+
+	#if !defined(ES_THREADING)
+		/*! (internal) Type feedback of a call instruction: the function called last and the built-in
+			Number operation it implements (RuntimeInternals::numberOperation_t).
+			\note The callee is only compared and not referenced. */
+		struct CallSiteFeedback{
+			const Object * callee;
+			uint8_t numberOperation;
+			CallSiteFeedback() : callee(nullptr),numberOperation(0){}
+		};
+		CallSiteFeedback & _accessCallSiteFeedback(uint32_t callSiteIdx)	{	return callSiteFeedback[callSiteIdx];	}
+	private:
+		std::vector<CallSiteFeedback> callSiteFeedback;
+	#endif // ES_THREADING
+	//	@}
 };
 }
 
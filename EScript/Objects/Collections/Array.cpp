@@ -13,11 +13,11 @@
 #include "../../Utils/StdConversions.h"
 #include "../../Consts.h"
 #include "../Callables/FnBinder.h"
+#include "../../Utils/ObjectPool.h"
 
 #include <iterator>
 #include <sstream>
 #include <string>
-#include <stack>
 #include <iostream>
 #include <random>
 namespace EScript{
@@ -151,19 +151,14 @@ void Array::init(EScript::Namespace & globals) {
 
 // -----------------------------------------------------------------------
 
-//! (static)
-std::stack<Array *> Array::pool;
+typedef ObjectPool<Array,100> ArrayPool;
 
 //! (static)
 Array * Array::create(Type * type){
 	Array * a = nullptr;
-	if( !(type==nullptr || type==Array::getTypeObject()) || pool.empty()){
-		a = new Array;
-	}else{
-		a = pool.top();
-		pool.pop();
-	}
-	return a;
+	if( type==nullptr || type==Array::getTypeObject() )
+		a = ArrayPool::getThreadLocalPool().pop();
+	return a ? a : new Array;
 }
 
 //! (static)
@@ -193,17 +188,12 @@ void Array::release(Array * a){
 	delete a;
 	return;
 	#endif
-	if(pool.size()<100 && a->getType()==Array::getTypeObject()){
+	if(a->getType()==Array::getTypeObject()){
 		a->clear();
-		pool.push(a);
-	}else{
-		delete a;
+		if(ArrayPool::getThreadLocalPool().push(a))
+			return;
 	}
-//	static size_t max = 0;
-//	if(pool.size()>max){
-//		std::cout << "\r"<<max;
-//		max = pool.size();
-//	}
+	delete a;
 }
 
 // -----------------------------------------------------------------------
@@ -242,6 +232,23 @@ Object * Array::clone()const {
 	return newArray;
 }
 
+//! ---|> [Object]
+void Array::_traverseReferences(const std::function<void(Object*)> & visit)const{
+	Object::_traverseReferences(visit);
+	for(const auto & element : data)
+		visit(element.get());
+}
+
+//! ---|> [Object]
+void Array::_releaseReferences(){
+	data.clear();
+}
+
+//! ---|> [Object]
+size_t Array::_getMemoryUsage()const{
+	return sizeof(Array) + data.capacity()*sizeof(value_type);
+}
+
 //! ---|> Collection
 Object * Array::getValue(ObjPtr key) {
 	if(key.isNull()) return nullptr;
@@ -344,12 +351,14 @@ std::string Array::implode(const std::string & delimiter/*=";"*/){
 	return sprinter.str();
 }
 
-static bool compare(Runtime & runtime,Object * function,Object * a,Object * b){
-	if(function!=nullptr) { // comparement function given?
-		return callFunction(runtime,function,ParameterValues(a,b)).toBool();
-	}else{
-		return callMemberFunction(runtime,a,Consts::IDENTIFIER_fn_less,ParameterValues(b)).toBool();
-	}
+/*! Sets @p aLessB to the result of comparing @p a and @p b and returns true.
+	\note On failure, false is returned and the exception remains pending. */
+static bool compare(Runtime & runtime,Object * function,Object * a,Object * b,bool & aLessB){
+	const std::pair<bool,ObjRef> result = function!=nullptr ? // comparement function given?
+			tryCallFunction(runtime,function,ParameterValues(a,b)) :
+			tryCallMemberFunction(runtime,a,Consts::IDENTIFIER_fn_less,ParameterValues(b));
+	aLessB = result.first && result.second.toBool();
+	return result.first;
 }
 
 
@@ -387,19 +396,18 @@ void Array::rt_sort(Runtime & runtime,Object * function/*=nullptr*/,bool reverse
 			Object * s3 = data[right].get();
 
 			// s1 < s2 < s3 || s1 > s2 > s3
-			const bool s1_lt_s2 = compare(runtime,function,s1,s2);
+			bool s1_lt_s2,s2_lt_s3;
+			if(!compare(runtime,function,s1,s2,s1_lt_s2))	return; // the exception remains pending
 //			++cCount;
-			if(!runtime.checkNormalState())	return;
-			const bool s2_lt_s3 = compare(runtime,function,s2,s3);
+			if(!compare(runtime,function,s2,s3,s2_lt_s3))	return;
 //			++cCount;
-			if(!runtime.checkNormalState())	return;
 			if( (s1_lt_s2&&s2_lt_s3) || (!s1_lt_s2 && !s2_lt_s3) ){
 				data[left].swap(data[center]);
 			}else{
 				// s1 < s3 < s2 || s1 > s3 > s2
-				const bool s1_lt_s3 = compare(runtime,function,s1,s3);
+				bool s1_lt_s3;
+				if(!compare(runtime,function,s1,s3,s1_lt_s3))	return;
 // 				++cCount;
-				if(!runtime.checkNormalState())	return;
 				if( (s1_lt_s3&&!s2_lt_s3) || (!s1_lt_s3 && s2_lt_s3) ){
 					data[left].swap(data[right]);
 //				}else{ // s2 < s1 < s3 || s2 > s1 > s3
@@ -411,10 +419,10 @@ void Array::rt_sort(Runtime & runtime,Object * function/*=nullptr*/,bool reverse
 			Object * di = data[i].get();
 			Object * dr = data[right].get();
 
-			const bool change = compare(runtime,function,di,dr);
-//			++cCount;
-			if(!runtime.checkNormalState())
+			bool change;
+			if(!compare(runtime,function,di,dr,change))
 				return;
+//			++cCount;
 
 			if(change^reverseOrder) {
 				data[i].swap(data[split]);
@@ -442,7 +450,10 @@ void Array::rt_filter(Runtime & runtime,ObjPtr function) {
 	ParameterValues parameters(1);
 	for(const auto & element : data) {
 		parameters.set(0, element);
-		if( callFunction(runtime,function.get(),parameters).toBool() ){
+		const std::pair<bool,ObjRef> result( tryCallFunction(runtime,function.get(),parameters) );
+		if(!result.first) // the exception remains pending; leave the array untouched.
+			return;
+		if( result.second.toBool() ){
 			tempArray.push_back(element);
 		}
 	}
@@ -48,8 +48,6 @@ class Array : public Collection {
 	//! @name Creation
 	// @{
 	private:
-		static std::stack<Array *> pool;
-
 		Array(Type * type = nullptr) : Collection(type?type:getTypeObject()){}
 
 		void init(const ParameterValues & p);
@@ -169,6 +167,9 @@ class Array : public Collection {
 	// @{
 		Object * clone()const override;
 		internalTypeId_t _getInternalTypeId()const override	{	return _TypeIds::TYPE_ARRAY;	}
+		void _traverseReferences(const std::function<void(Object*)> & visit)const override;
+		void _releaseReferences() override;
+		size_t _getMemoryUsage()const override;
 	//	@}
 
 	//---------------------
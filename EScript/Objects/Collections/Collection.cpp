@@ -167,7 +167,10 @@ Object * Collection::rt_reduce(Runtime & runtime,ObjPtr function,ObjPtr initialV
 		parameters.set(0,runningVar);
 		parameters.set(1,key);
 		parameters.set(2,value);
-		runningVar = callFunction(runtime,function.get(),parameters);
+		std::pair<bool,ObjRef> result( tryCallFunction(runtime,function.get(),parameters) );
+		if(!result.first) // the exception remains pending
+			return nullptr;
+		runningVar = std::move(result.second);
 	}
 	return runningVar.detachAndDecrease();
 }
@@ -198,7 +201,10 @@ bool Collection::rt_isEqual(Runtime &runtime,const ObjPtr & other){
  */
 Object * Collection::rt_map(Runtime & runtime,ObjPtr function, const ParameterValues & additionalValues){
 	// Create new, empty Collection
-	ObjRef obj = runtime.createInstance(getType(),ParameterValues());
+	std::pair<bool,ObjRef> creationResult( std::move(runtime.tryCreateInstance(getType(),ParameterValues())) );
+	if(!creationResult.first)
+		return nullptr;
+	ObjRef obj( std::move(creationResult.second) );
 	ERef<Collection> newCollectionRef = obj.castTo<Collection>();
 	if(newCollectionRef.isNull()){
 		runtime.setException("Collection.map(..) No Constructor found!");
@@ -216,7 +222,10 @@ Object * Collection::rt_map(Runtime & runtime,ObjPtr function, const ParameterVa
 		ObjRef value = it->value();
 		parameters.set(0,key);
 		parameters.set(1,value);
-		ObjRef newValue = runtime.executeFunction(function.get(),nullptr,parameters);
+		std::pair<bool,ObjRef> result( runtime.tryExecuteFunction(function.get(),nullptr,parameters) );
+		if(!result.first) // the exception remains pending
+			return nullptr;
+		ObjRef newValue( std::move(result.second) );
 		if(!newValue.isNull())
 			newCollectionRef->setValue(key.get(),newValue.get());
 	}
@@ -234,7 +243,10 @@ Object * Collection::rt_extract(Runtime & runtime,StringId functionId,bool decis
 		if(currentValue.isNull()) {
 			currentValue = value;
 		} else {
-			if(callMemberFunction(runtime,value.get(),functionId,ParameterValues(currentValue.get())).toBool()==decision)
+			std::pair<bool,ObjRef> result( tryCallMemberFunction(runtime,value.get(),functionId,ParameterValues(currentValue.get())) );
+			if(!result.first)
+				return nullptr;
+			if(result.second.toBool()==decision)
 				currentValue = value;
 		}
 		it->next();
@@ -10,6 +10,7 @@
 #define COLLECTION_H
 
 #include "../Type.h"
+#include "../../Utils/CycleCollector.h"
 #include "../../Utils/ObjArray.h"
 
 namespace EScript {
@@ -22,7 +23,7 @@ class Collection : public Object {
 		static Type* getTypeObject();
 		static void init(Namespace & globals);
 		// ---
-		Collection(Type * type = nullptr) : Object(type?type:getTypeObject()) { }
+		Collection(Type * type = nullptr) : Object(type?type:getTypeObject())	{	CycleCollector::registerObject(this);	}
 		virtual ~Collection()	{ }
 
 		//! ---o
@@ -163,6 +163,25 @@ Object * Map::clone()const {
 	return newMap;
 }
 
+//! ---|> [Object]
+void Map::_traverseReferences(const std::function<void(Object*)> & visit)const{
+	Object::_traverseReferences(visit);
+	for(const auto & keyEntryPair : data){
+		visit(keyEntryPair.second.key.get());
+		visit(keyEntryPair.second.value.get());
+	}
+}
+
+//! ---|> [Object]
+void Map::_releaseReferences(){
+	data.clear();
+}
+
+//! ---|> [Object]
+size_t Map::_getMemoryUsage()const{
+	return sizeof(Map) + data.size()*sizeof(container_t::value_type);
+}
+
 void Map::rt_filter(Runtime & runtime,ObjPtr function, const ParameterValues & additionalValues) {
 	container_t tempMap;
 
@@ -174,7 +193,10 @@ void Map::rt_filter(Runtime & runtime,ObjPtr function, const ParameterValues & a
 		const MapEntry & sourceEntry = keyEntryPair.second;
 		parameters.set(0,sourceEntry.key);
 		parameters.set(1,sourceEntry.value);
-		if( callFunction(runtime,function.get(),parameters).toBool() ){
+		std::pair<bool,ObjRef> result( tryCallFunction(runtime,function.get(),parameters) );
+		if(!result.first) // the exception remains pending; leave the map untouched.
+			return;
+		if( result.second.toBool() ){
 			tempMap[keyEntryPair.first] = sourceEntry;
 		}
 	}
@@ -146,6 +146,9 @@ class Map : public Collection {
 	//! @name ---|> [Object]
 	// @{
 		Object * clone()const;
+		void _traverseReferences(const std::function<void(Object*)> & visit)const override;
+		void _releaseReferences() override;
+		size_t _getMemoryUsage()const override;
 	//	@}
 
 	//---------------------
@@ -10,6 +10,7 @@
 
 #include "../Basics.h"
 #include "../StdObjects.h"
+#include "../Utils/CycleCollector.h"
 
 namespace EScript{
 
@@ -51,10 +52,11 @@ ExtObject * ExtObject::create(){
 
 //! (ctor)
 ExtObject::ExtObject() : Object(ExtObject::getTypeObject()) {
-	//ctor
+	CycleCollector::registerObject(this);
 }
 
 ExtObject::ExtObject(const ExtObject & other): Object(other.getType()){
+	CycleCollector::registerObject(this);
 //	if(typeRef)
 //		typeRef->copyObjAttributesTo(this);
 	cloneAttributesFrom(&other);
@@ -62,9 +64,9 @@ ExtObject::ExtObject(const ExtObject & other): Object(other.getType()){
 
 //! (ctor)
 ExtObject::ExtObject(Type * type) : Object(type) {
+	CycleCollector::registerObject(this);
 	if(typeRef)
-		typeRef->copyObjAttributesTo(this);
-	//ctor
+		typeRef->copyObjAttributesTo(objAttributes);
 }
 
 
@@ -116,6 +118,22 @@ bool ExtObject::setAttribute(const StringId & id,const Attribute & attr){
 	return true;
 }
 
+Object::AttributeReference_t ExtObject::_accessOrAddLocalAttribute(const StringId & id,const Attribute & attr){
+#if defined(ES_THREADING)
+	SyncTools::FastLockHolder mutexHolder( attributesMutex );
+#endif
+	Attribute * localAttr = objAttributes.accessAttribute(id);
+	if(!localAttr){
+		objAttributes.setAttribute(id,attr);
+		localAttr = objAttributes.accessAttribute(id);
+	}
+#if defined(ES_THREADING)
+	return std::move(std::make_tuple(localAttr,std::move(mutexHolder)));
+#else
+	return std::make_tuple(localAttr);
+#endif
+}
+
 void ExtObject::cloneAttributesFrom(const ExtObject * obj) {
 #if defined(ES_THREADING)
 	SyncTools::FastLockHolder mutexHolder( attributesMutex );
@@ -130,4 +148,26 @@ std::unordered_map<StringId,ObjRef> ExtObject::collectLocalAttributes(){
 #endif
 	return std::move(objAttributes.collectAttributes());
 }
+
+// ---------------------------------------------------------------------------------------
+// cycle collection
+// \note The attributes are not locked: The CycleCollector only accesses objects that are not referenced by other threads.
+
+//! ---|> Object
+void ExtObject::_traverseReferences(const std::function<void(Object*)> & visit)const{
+	Object::_traverseReferences(visit);
+	for(const auto & keyValuePair : objAttributes)
+		visit(keyValuePair.second.getValue().get());
+}
+
+//! ---|> Object
+void ExtObject::_releaseReferences(){
+	objAttributes.clear();
+}
+
+//! ---|> Object
+size_t ExtObject::_getMemoryUsage()const{
+	return sizeof(ExtObject) + objAttributes.size()*sizeof(AttributeContainer::value_type);
+}
+
 }
@@ -63,9 +63,21 @@ class ExtObject : public Object {
 		std::unordered_map<StringId,ObjRef> collectLocalAttributes() override;
 
 		void cloneAttributesFrom(const ExtObject * obj);
+
+		/*! (internal) Access the local attribute with the given id; if it does not exist, @p attr is added before.
+			\note Other than a combination of _accessAttribute(...) and setAttribute(...), this is atomic. */
+		AttributeReference_t _accessOrAddLocalAttribute(const StringId & id,const Attribute & attr);
+
+		//! ---|> [Object]
+		void _traverseReferences(const std::function<void(Object*)> & visit)const override;
+		//! ---|> [Object]
+		void _releaseReferences() override;
+		//! ---|> [Object]
+		size_t _getMemoryUsage()const override;
 		
 	private:
 		friend class RuntimeInternals;
+		friend class Namespace;
 		AttributeContainer objAttributes;
 	#if defined(ES_THREADING)
 		SyncTools::FastLock attributesMutex;
@@ -10,6 +10,8 @@
 
 #include "../Basics.h"
 
+#include <atomic>
+
 namespace EScript{
 
 //! (static)
@@ -27,15 +29,131 @@ void Namespace::init(EScript::Namespace & globals) {
 	declareConstant(&globals,getClassName(),typeObject);
 
 	//! [ESMF] Namespace new Namespace
-	ES_CTOR(typeObject,0,0, new Namespace)
+	ES_CTOR(typeObject,0,0, new Namespace(thisType))
+
+	//! [ESMF] Namespace Namespace._createLayer()	\see Namespace::createLayer(...)
+	ES_MFUN(typeObject,Namespace,"_createLayer",0,0, Namespace::createLayer(thisObj))
 }
 
 //---
 
+//! (static,internal)
+uint64_t Namespace::createSerialNumber(){
+	static std::atomic<uint64_t> counter(0);
+	return ++counter; // 0 is never used
+}
+
+//! (static)
+Namespace * Namespace::createLayer(Namespace * ns){
+	ERef<Namespace> content( new Namespace(ns->getType()) ); // takes the current local attributes of ns, if there are any
+	content->immutable = true;
+	Namespace * layer = new Namespace(ns->getType());
+	{
+	#if defined(ES_THREADING)
+		SyncTools::FastLockHolder mutexHolder( ns->attributesMutex );
+	#endif
+		if(ns->immutable){
+			layer->baseLayer = ns;
+		}else{
+			if(!ns->baseLayer || ns->objAttributes.size()>0){
+				content->objAttributes.swap(ns->objAttributes);
+				if(ns->layerDepth<MAX_LAYER_DEPTH){
+					content->baseLayer = ns->baseLayer;
+					content->layerDepth = ns->layerDepth;
+				}else{ // merge the base layers, as each missing attribute is searched in all of them
+					for(Namespace * base = ns->baseLayer.get(); base; base = base->baseLayer.get()){
+						// base layers are immutable and can be read without locking
+						for(const auto & keyValuePair : base->objAttributes){
+							if(!content->objAttributes.accessAttribute(keyValuePair.first))
+								content->objAttributes.setAttribute(keyValuePair.first,keyValuePair.second);
+						}
+					}
+				}
+				ns->baseLayer = content;
+				ns->layerDepth = content->layerDepth+1;
+				ns->serialNumber = createSerialNumber(); // references to the moved attributes must not be used by ns anymore
+			}
+			layer->baseLayer = ns->baseLayer;
+		}
+		layer->layerDepth = layer->baseLayer->layerDepth+1;
+	}
+	return layer;
+}
+
+//! (internal) The base layer of a mutable Namespace may be replaced by createLayer(...).
+ERef<Namespace> Namespace::getBaseLayerLocked(){
+#if defined(ES_THREADING)
+	SyncTools::FastLockHolder mutexHolder( attributesMutex );
+#endif
+	return baseLayer;
+}
+
 //! ---|> [Object]
 Namespace * Namespace::clone() const{
-	Namespace * c = new Namespace(getType());
-	c->cloneAttributesFrom(this);
+	Namespace * c = baseLayer ? baseLayer->clone() : new Namespace(getType());
+	c->cloneAttributesFrom(this); // the layer's attributes replace the base's ones
 	return c;
 }
+
+//! ---|> [ExtObject]
+Object::AttributeReference_t Namespace::_accessAttribute(const StringId & id,bool localOnly){
+	ERef<Namespace> base;
+	{
+	#if defined(ES_THREADING)
+		SyncTools::FastLockHolder mutexHolder( attributesMutex );
+		Attribute * attr = objAttributes.accessAttribute(id);
+		if( attr )
+			return std::move(std::make_tuple(attr,std::move(mutexHolder)));
+	#else
+		Attribute * attr = objAttributes.accessAttribute(id);
+		if( attr )
+			return std::make_tuple(attr);
+	#endif
+		base = baseLayer;
+	}
+	if(base){
+		if(immutable) // all layers below are immutable as well; nothing has to be copied
+			return base->_accessAttribute(id,localOnly);
+		// copy on first access, as the returned attribute may be modified
+		const Attribute baseAttr( base->getLocalAttribute(id) );
+		if(baseAttr)
+			return _accessOrAddLocalAttribute(id,Attribute(baseAttr.getValue()->getRefOrCopy(),baseAttr.getProperties()));
+	}
+	if(localOnly || !getType() )
+#if defined(ES_THREADING)
+		return std::move(std::make_tuple(nullptr,SyncTools::FastLockHolder()));
+#else
+		return std::make_tuple(nullptr);
+#endif
+	return std::move(getType()->findTypeAttribute(id));
+}
+
+//! ---|> [ExtObject]
+bool Namespace::setAttribute(const StringId & id,const Attribute & attr){
+	return immutable ? false : ExtObject::setAttribute(id,attr);
+}
+
+//! ---|> [ExtObject]
+std::unordered_map<StringId,ObjRef> Namespace::collectLocalAttributes(){
+	std::unordered_map<StringId,ObjRef> localAttrs( ExtObject::collectLocalAttributes() );
+	const ERef<Namespace> base( getBaseLayerLocked() );
+	if(!base)
+		return localAttrs;
+	std::unordered_map<StringId,ObjRef> attrs( base->collectLocalAttributes() );
+	for(auto & keyValuePair : localAttrs)
+		attrs[keyValuePair.first] = std::move(keyValuePair.second);
+	return attrs;
+}
+
+//! ---|> [ExtObject]
+void Namespace::_traverseReferences(const std::function<void(Object*)> & visit)const{
+	ExtObject::_traverseReferences(visit);
+	visit(baseLayer.get());
+}
+
+//! ---|> [ExtObject]
+void Namespace::_releaseReferences(){
+	ExtObject::_releaseReferences();
+	baseLayer = nullptr;
+}
 }
@@ -11,21 +11,69 @@
 
 #include "ExtObject.h"
 
+#include <cstdint>
+
 namespace EScript {
 
-//! [Namespace] ---|> [ExtObject] ---|> [Object]
+/*! [Namespace] ---|> [ExtObject] ---|> [Object]
+	A Namespace may be a layer on top of a base Namespace (copy-on-write): The base's attributes are
+	visible as local attributes of the layer. When such an attribute is accessed the first time, it is
+	copied into the layer; all modifications only affect the layer. Creating a layer is cheap, which is
+	used for the globals of new and forked Runtimes.
+	A base Namespace is immutable: Its attributes are not copied on access and setting an attribute fails.
+	Therefore, it can be read by several threads without copying it.	*/
 class Namespace : public ExtObject {
 		ES_PROVIDES_TYPE_NAME(Namespace)
 	public:
 		static Type* getTypeObject();
 		static void init(EScript::Namespace & globals);
 
-		Namespace() : ExtObject()					{	}
-		Namespace(Type * type) : ExtObject(type)	{	}
+		/*! (static) Create a Namespace layered on top of the current content of @p ns.
+			The local attributes of @p ns are moved into a new immutable base Namespace, which becomes the base
+			of @p ns and of the new layer. Afterwards, modifications of @p ns are not visible in the layer and vice versa. */
+		static Namespace * createLayer(Namespace * ns);
+
+		Namespace() : ExtObject(),serialNumber(createSerialNumber()),immutable(false),layerDepth(0)					{	}
+		Namespace(Type * type) : ExtObject(type),serialNumber(createSerialNumber()),immutable(false),layerDepth(0)	{	}
 		virtual ~Namespace()						{	}
 
 		//! ---|> [Object]
 		Namespace * clone() const override;
+
+		Namespace * getBaseLayer()const				{	return baseLayer.get();	}
+		//! Returns true iff this Namespace is the base of other Namespaces; its attributes must not be modified.
+		bool isImmutable()const						{	return immutable;	}
+
+		using ExtObject::_accessAttribute;
+		using ExtObject::setAttribute;
+		/*! ---|> [ExtObject]
+			\note The attributes of an immutable Namespace are returned without copying them; they must not be modified. */
+		AttributeReference_t _accessAttribute(const StringId & id,bool localOnly) override;
+		//! ---|> [ExtObject] Fails if the Namespace is immutable.
+		bool setAttribute(const StringId & id,const Attribute & attr) override;
+		//! ---|> [ExtObject]
+		std::unordered_map<StringId,ObjRef> collectLocalAttributes() override;
+
+		//! ---|> [ExtObject]
+		void _traverseReferences(const std::function<void(Object*)> & visit)const override;
+		//! ---|> [ExtObject]
+		void _releaseReferences() override;
+
+		/*! Number identifying the storage of this Namespace's local attributes; it is never reused by another Namespace.
+			It is renewed when the local attributes are moved by createLayer(...).
+			Used by the Runtime to validate cached references to global variables. */
+		uint64_t getSerialNumber()const				{	return serialNumber;	}
+	private:
+		//! A base Namespace's attributes are merged into a single Namespace if the layers get deeper than this.
+		static const uint32_t MAX_LAYER_DEPTH = 8;
+
+		static uint64_t createSerialNumber();
+		ERef<Namespace> getBaseLayerLocked();
+
+		uint64_t serialNumber;
+		bool immutable;
+		uint32_t layerDepth; //!< number of base layers below this Namespace
+		ERef<Namespace> baseLayer;
 };
 
 }
@@ -13,6 +13,7 @@
 #include "../Objects/Callables/FnBinder.h"
 #include "../Objects/Exception.h"
 #include "../Objects/Identifier.h"
+#include "../Utils/CycleCollector.h"
 #include <iostream>
 #include <sstream>
 
@@ -191,7 +192,10 @@ void ObjectReleaseHandler::release(Object * o) {
 
 //! Constructor.
 Object::Object():
-		typeRef( getTypeObject() ){
+		collectorIndex(CycleCollector::NOT_TRACKED), typeRef( getTypeObject() ){
+#if defined(ES_THREADING)
+	collectorRegistry = nullptr;
+#endif
 #ifdef ES_DEBUG_MEMORY
 	Debug::registerObj(this);
 #endif
@@ -199,7 +203,10 @@ Object::Object():
 
 //! Constructor.
 Object::Object(Type * _type):
-		typeRef( _type ){
+		collectorIndex(CycleCollector::NOT_TRACKED), typeRef( _type ){
+#if defined(ES_THREADING)
+	collectorRegistry = nullptr;
+#endif
 #ifdef ES_DEBUG_MEMORY
 	Debug::registerObj(this);
 #endif
@@ -207,6 +214,8 @@ Object::Object(Type * _type):
 
 //! Destructor.
 Object::~Object() {
+	if(collectorIndex!=CycleCollector::NOT_TRACKED)
+		CycleCollector::unregisterObject(this);
 #ifdef ES_DEBUG_MEMORY
 	Debug::unRegisterObj(this);
 #endif
@@ -215,6 +224,11 @@ Object::~Object() {
 //! ---o
 void Object::_initAttributes(Runtime &){}
 
+//! ---o
+void Object::_traverseReferences(const std::function<void(Object*)> & visit)const{
+	visit(typeRef.get());
+}
+
 //! ---o
 Object * Object::clone() const {
 	return new Object(getType());
@@ -318,6 +332,22 @@ Object::AttributeReference_t Object::_accessAttribute(const StringId & id,bool l
 	}
 }
 
+//! (static,internal)
+void Object::_assignToAccessedAttribute(AttributeReference_t & attrRef,const StringId & id,ObjPtr value){
+#if defined(ES_THREADING)
+	Type * owningType = std::get<1>(attrRef).owningType;
+	if(owningType){
+		std::get<1>(attrRef).unlock();
+		std::get<0>(attrRef) = nullptr;
+		owningType->_assignTypeAttributeValue(id,value);
+		return;
+	}
+#else
+	(void)id;
+#endif
+	std::get<0>(attrRef)->setValue(value.get());
+}
+
 Attribute Object::getLocalAttribute(const StringId & id)const{
 	auto attrHolder( std::move(const_cast<Object*>(this)->_accessAttribute(id,true)));
 	const Attribute * attr = std::get<0>(attrHolder);
@@ -13,12 +13,14 @@
 #include "../Utils/ObjRef.h"
 #include "../Utils/Hashing.h"
 #include "../Utils/EReferenceCounter.h"
+#include "../Utils/CycleCollector.h"
 #if defined(ES_THREADING)
 #include "../Utils/SyncTools.h"
 #endif // defined
 
 #include "typeIds.h"
 
+#include <functional>
 #include <ostream>
 #include <unordered_map>
 
@@ -88,6 +90,32 @@ class Object:public EReferenceCounter<Object,ObjectReleaseHandler>  {
 
 	// -------------------------
 
+	//! @name Cycle collection
+	//	@{
+	private:
+		friend class CycleCollector;
+		uint32_t collectorIndex;
+	#if defined(ES_THREADING)
+		CycleCollector::Registry * collectorRegistry; //!< The registry of the thread that tracks the object.
+	#endif
+	public:
+		/*! ---o (internal)
+			Call @p visit for each counted reference held by the object (used by the CycleCollector).
+			\note A missing reference only prevents a cycle from being collected; a reference that is
+				not counted by the object must never be reported. */
+		virtual void _traverseReferences(const std::function<void(Object*)> & visit)const;
+
+		/*! ---o (internal)
+			Release all references reported by _traverseReferences(...) except for the type.
+			Called by the CycleCollector for unreachable objects. */
+		virtual void _releaseReferences()					{	}
+
+		//! ---o (internal) Estimated number of bytes used by the object.
+		virtual size_t _getMemoryUsage()const				{	return sizeof(Object);	}
+	//	@}
+
+	// -------------------------
+
 	//! @name Type
 	//	@{
 	protected:
@@ -104,11 +132,35 @@ class Object:public EReferenceCounter<Object,ObjectReleaseHandler>  {
 	//! @name Attributes
 	public:
 #if defined(ES_THREADING)
-		typedef std::tuple<Attribute*,SyncTools::FastLockHolder> AttributeReference_t;
+		/*! (internal) Keeps an accessed attribute valid. Either the lock of the attribute's owner is held, or
+			the attribute belongs to the published attribute table of a Type, which is read without locking.
+			Such an attribute must not be modified directly; use _assignToAccessedAttribute(...) instead. */
+		struct AttributeGuard{
+			SyncTools::FastLockHolder lock;
+			SyncTools::ReadSection readSection;
+			Type * owningType;
+
+			AttributeGuard() : owningType(nullptr)	{}
+			AttributeGuard(SyncTools::FastLockHolder && _lock) : lock(std::move(_lock)),owningType(nullptr)	{}
+			AttributeGuard(SyncTools::ReadSection && _readSection,Type * _owningType) :
+					readSection(std::move(_readSection)),owningType(_owningType)	{}
+
+			//! Release the attribute; it must not be accessed afterwards.
+			void unlock(){
+				if(lock.owns_lock())
+					lock.unlock();
+				readSection.leave();
+			}
+		};
+		typedef std::tuple<Attribute*,AttributeGuard> AttributeReference_t;
 #else
 		typedef std::tuple<Attribute*> AttributeReference_t;
 #endif // ES_THREADING
 
+		/*! (static,internal) Assign a new value to an attribute accessed by _accessAttribute(...).
+			\note Has to be used instead of Attribute::setValue(...), as a Type's attribute may not be modified in place. */
+		static void _assignToAccessedAttribute(AttributeReference_t & attrRef,const StringId & id,ObjPtr value);
+
 		/*! ---o (internal)
 			Get access to an Attribute stored at this Object.
 			\note Should not be called directly. Use get(Local)Attribute(...) instead.
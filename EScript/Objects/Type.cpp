@@ -9,12 +9,15 @@
 #include "Type.h"
 
 #include "../Basics.h"
+#include "../Consts.h"
 #include "../StdObjects.h"
 #include "Identifier.h"
 #include "Exception.h"
+#include "../Utils/CycleCollector.h"
 #if defined(ES_THREADING)
 #include "../Utils/SyncTools.h"
 #endif // ES_THREADING
+#include <atomic>
 
 namespace EScript{
 
@@ -75,33 +78,60 @@ void Type::init(EScript::Namespace & globals) {
 
 //---
 
+#if defined(ES_THREADING)
+std::atomic<uint32_t> Type::lookupVersion(1);
+#else
+uint32_t Type::lookupVersion = 1;
+#endif // ES_THREADING
+
+//! (static,internal)
+uint64_t Type::createSerialNumber(){
+	static std::atomic<uint64_t> counter(0);
+	return ++counter; // 0 is never used
+}
+
 //! (ctor)
 Type::Type():
-	Object(Type::getTypeObject()),flags(0),baseType(Object::getTypeObject()) {
-	//ctor
+	Object(Type::getTypeObject()),serialNumber(createSerialNumber()),flags(0),baseType(Object::getTypeObject()) {
+#if defined(ES_THREADING)
+	publishedAttributes = nullptr;
+	publishedAttributesOutdated = false;
+#endif // ES_THREADING
+	CycleCollector::registerObject(this);
+	initAncestors();
 }
 
 //! (ctor)
 Type::Type(Type * _baseType):
-		Object(Type::getTypeObject()),flags(0),baseType(_baseType) {
-
-	if(getBaseType())
-		getBaseType()->copyObjAttributesTo(this);
-	//ctor
+		Object(Type::getTypeObject()),serialNumber(createSerialNumber()),flags(0),baseType(_baseType) {
+#if defined(ES_THREADING)
+	publishedAttributes = nullptr;
+	publishedAttributesOutdated = false;
+#endif // ES_THREADING
+	CycleCollector::registerObject(this);
+	initAncestors();
+	inheritObjAttributes();
 }
 
 //! (ctor)
 Type::Type(Type * _baseType,Type * typeOfType):
-		Object(typeOfType),flags(0),baseType(_baseType) {
-
-	if(getBaseType())
-		getBaseType()->copyObjAttributesTo(this);
-	//ctor
+		Object(typeOfType),serialNumber(createSerialNumber()),flags(0),baseType(_baseType) {
+#if defined(ES_THREADING)
+	publishedAttributes = nullptr;
+	publishedAttributesOutdated = false;
+#endif // ES_THREADING
+	CycleCollector::registerObject(this);
+	initAncestors();
+	inheritObjAttributes();
 }
 
 //! (dtor)
 Type::~Type() {
-	//dtor
+#if defined(ES_THREADING)
+	AttributeContainer * published = publishedAttributes.exchange(nullptr);
+	if(published)
+		SyncTools::retire([published](){	delete published;	});
+#endif // ES_THREADING
 }
 
 //! ---|> [Object]
@@ -116,13 +146,20 @@ static const char * typeAttrErrorHint =
 
 
 Object::AttributeReference_t Type::findTypeAttribute(const StringId & id){
+#if defined(ES_THREADING)
+	// the published attribute tables are read without locking.
+	SyncTools::ReadSection readSection;
+	readSection.enter();
+#endif // ES_THREADING
 	Type * t = this;
 	do{
 		{
 #if defined(ES_THREADING)
-			SyncTools::FastLockHolder dbLock(t->attributesMutex);
-#endif // ES_THREADING
+			AttributeContainer * published = t->getPublishedAttributes();
+			Attribute * attr = published ? published->accessAttribute(id) : nullptr;
+#else
 			Attribute * attr = t->attributes.accessAttribute(id);
+#endif // ES_THREADING
 			if( attr ){
 				if( attr->isObjAttribute() ){
 					std::string message = "(findTypeAttribute) type-attribute expected but object-attribute found. ('";
@@ -130,7 +167,7 @@ Object::AttributeReference_t Type::findTypeAttribute(const StringId & id){
 					throw new Exception(message);
 				}
 #if defined(ES_THREADING)
-				return std::make_tuple(attr,std::move(dbLock));
+				return std::make_tuple(attr,AttributeGuard(std::move(readSection),t));
 #else
 				return std::make_tuple(attr);
 #endif // ES_THREADING
@@ -139,7 +176,7 @@ Object::AttributeReference_t Type::findTypeAttribute(const StringId & id){
 		t = t->getBaseType();
 	}while(t);
 #if defined(ES_THREADING)
-	return std::make_tuple(nullptr,SyncTools::FastLockHolder());
+	return std::make_tuple(nullptr,AttributeGuard());
 #else
 	return std::make_tuple(nullptr);
 #endif // ES_THREADING
@@ -151,13 +188,15 @@ Object::AttributeReference_t Type::_accessAttribute(const StringId & id,bool loc
 	// is local attribute?
 #if defined(ES_THREADING)
 	{
-		SyncTools::FastLockHolder mutexHolder( attributesMutex );
-		Attribute * attr = attributes.accessAttribute(id);
+		SyncTools::ReadSection readSection;
+		readSection.enter();
+		AttributeContainer * published = getPublishedAttributes();
+		Attribute * attr = published ? published->accessAttribute(id) : nullptr;
 		if( attr )
-			return std::move(std::make_tuple(attr,std::move(mutexHolder)));
+			return std::move(std::make_tuple(attr,AttributeGuard(std::move(readSection),this)));
 	}
 	if(localOnly)
-		return std::move(std::make_tuple(nullptr,SyncTools::FastLockHolder()));
+		return std::move(std::make_tuple(nullptr,AttributeGuard()));
 #else
 	{
 		Attribute* const attr = attributes.accessAttribute(id);
@@ -177,7 +216,7 @@ Object::AttributeReference_t Type::_accessAttribute(const StringId & id,bool loc
 	if(getType())
 		return std::move( getType()->findTypeAttribute(id));
 #if defined(ES_THREADING)
-	return std::move(std::make_tuple(nullptr,SyncTools::FastLockHolder()));
+	return std::move(std::make_tuple(nullptr,AttributeGuard()));
 #else
 	return std::move(std::make_tuple(nullptr));
 #endif
@@ -189,19 +228,65 @@ bool Type::setAttribute(const StringId & id,const Attribute & attr){
 #if defined(ES_THREADING)
 	SyncTools::FastLockHolder mutexHolder( attributesMutex );
 #endif
+	if(!attributes.accessAttribute(id))
+		increaseLookupVersion();
 	attributes.setAttribute(id,attr);
 	if(attr.isObjAttribute())
 		setFlag(FLAG_CONTAINS_OBJ_ATTRS,true);
+#if defined(ES_THREADING)
+	publishedAttributesOutdated = true;
+#endif
 	return true;
 }
 
-void Type::copyObjAttributesTo(Object * instance){
-	// init member vars of type
 #if defined(ES_THREADING)
+void Type::_assignTypeAttributeValue(const StringId & id,ObjPtr value){
 	SyncTools::FastLockHolder mutexHolder( attributesMutex );
-#endif
+	Attribute * attr = attributes.accessAttribute(id);
+	if(attr){
+		attr->setValue(value.get());
+		publishedAttributesOutdated = true;
+	}
+}
+
+//! (internal)
+void Type::publishAttributes(SyncTools::FastLockHolder & attributesLock){
+	publishedAttributesOutdated = false;
+	// the copy shares the values (in contrast to AttributeContainer's copy constructor)
+	AttributeContainer * published = new AttributeContainer;
+	for(const auto & keyValuePair : attributes)
+		published->setAttribute(keyValuePair.first,keyValuePair.second);
+	AttributeContainer * old = publishedAttributes.exchange(published);
+	// deleting the old copy may release other objects, so the lock is released first.
+	attributesLock.unlock();
+	if(old)
+		SyncTools::retire([old](){	delete old;	});
+}
+
+//! (internal)
+AttributeContainer * Type::getPublishedAttributes(){
+	if(publishedAttributesOutdated){
+		SyncTools::FastLockHolder mutexHolder( attributesMutex );
+		if(publishedAttributesOutdated) // not yet published by another thread
+			publishAttributes(mutexHolder);
+	}
+	return publishedAttributes.load();
+}
+#endif // ES_THREADING
+
+void Type::copyObjAttributesTo(Object * instance){
+	// init member vars of type
 	if(getFlag(FLAG_CONTAINS_OBJ_ATTRS)){
+#if defined(ES_THREADING)
+		SyncTools::ReadSection readSection;
+		readSection.enter();
+		const AttributeContainer * published = getPublishedAttributes();
+		if(!published)
+			return;
+		for(const auto & keyValuePair : *published) {
+#else
 		for(const auto & keyValuePair : attributes) {
+#endif
 			const Attribute & a = keyValuePair.second;
 			if( a.isNull() || a.isTypeAttribute() )
 				continue;
@@ -210,6 +295,38 @@ void Type::copyObjAttributesTo(Object * instance){
 	}
 }
 
+void Type::copyObjAttributesTo(AttributeContainer & instanceAttributes){
+	if(getFlag(FLAG_CONTAINS_OBJ_ATTRS)){
+#if defined(ES_THREADING)
+		SyncTools::ReadSection readSection;
+		readSection.enter();
+		const AttributeContainer * published = getPublishedAttributes();
+		if(!published)
+			return;
+		for(const auto & keyValuePair : *published) {
+#else
+		for(const auto & keyValuePair : attributes) {
+#endif
+			const Attribute & a = keyValuePair.second;
+			if( !a.isNull() && a.isObjAttribute() )
+				instanceAttributes.setAttribute(keyValuePair.first, Attribute(std::move(a.getValue()->getRefOrCopy()),a.getProperties()));
+		}
+	}
+}
+
+#if !defined(ES_THREADING)
+//! (internal)
+void Type::initConstructionPlan(){
+	constructionPlan.constructors.clear();
+	for(Type * t = this; t; t = t->getBaseType()){
+		const Attribute * ctorAttr = t->attributes.accessAttribute(Consts::IDENTIFIER_fn_constructor);
+		if(ctorAttr)
+			constructionPlan.constructors.emplace_back(t,ctorAttr);
+	}
+	constructionPlan.lookupVersion = lookupVersion;
+}
+#endif // ES_THREADING
+
 std::unordered_map<StringId,ObjRef> Type::collectTypeAttributes()const{
 #if defined(ES_THREADING)
 	SyncTools::FastLockHolder mutexHolder( attributesMutex );
@@ -245,22 +362,63 @@ std::unordered_map<StringId,ObjRef> Type::collectLocalAttributes(){
 	return std::move(attrs);
 }
 
-bool Type::hasBase(const Type * type) const {
-	for(const Type * t = this; t; t = t->getBaseType()){
-		if(t==type)
-			return true;
+//! (internal)
+void Type::initAncestors(){
+	if(getBaseType()){
+		ancestors.reserve(getBaseType()->ancestors.size()+1);
+		ancestors = getBaseType()->ancestors;
 	}
-	return false;
+	ancestors.push_back(this);
 }
 
-bool Type::isBaseOf(const Type * type) const {
-	while(type){
-		if(type==this)
-			return true;
-		type = type->getBaseType();
+/*! The new Type is not yet known to any cached lookup, so the attributes are set without changing the
+	lookup version (unlike setAttribute(...)).	*/
+void Type::inheritObjAttributes(){
+	Type * base = getBaseType();
+	if(!base || !base->getFlag(FLAG_CONTAINS_OBJ_ATTRS))
+		return;
+	base->copyObjAttributesTo(attributes);
+	if(attributes.size()>0)
+		setFlag(FLAG_CONTAINS_OBJ_ATTRS,true);
+#if defined(ES_THREADING)
+	publishedAttributesOutdated = true;
+#endif
+}
+
+// ---------------------------------------------------------------------------------------
+// cycle collection
+
+//! ---|> Object
+void Type::_traverseReferences(const std::function<void(Object*)> & visit)const{
+	Object::_traverseReferences(visit);
+	visit(baseType.get());
+	for(const auto & keyValuePair : attributes)
+		visit(keyValuePair.second.getValue().get());
+#if defined(ES_THREADING)
+	// the published copy holds references to the same values
+	const AttributeContainer * published = publishedAttributes.load();
+	if(published){
+		for(const auto & keyValuePair : *published)
+			visit(keyValuePair.second.getValue().get());
 	}
-	return false;
+#endif // ES_THREADING
 }
 
+//! ---|> Object
+void Type::_releaseReferences(){
+	increaseLookupVersion();
+#if defined(ES_THREADING)
+	SyncTools::FastLockHolder mutexHolder( attributesMutex );
+	attributes.clear();
+	publishAttributes(mutexHolder);
+#else
+	attributes.clear();
+#endif // ES_THREADING
+}
+
+//! ---|> Object
+size_t Type::_getMemoryUsage()const{
+	return sizeof(Type) + attributes.size()*sizeof(AttributeContainer::value_type);
+}
 
 }
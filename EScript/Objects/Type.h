@@ -17,6 +17,7 @@
 #endif
 
 #include <cstdint>
+#include <vector>
 
 namespace EScript {
 
@@ -46,6 +47,12 @@ class Type : public Object {
 		//! ---|> [Object]
 		Object * clone() const override;
 		internalTypeId_t _getInternalTypeId()const override	{	return _TypeIds::TYPE_TYPE;	}
+
+		//! Unique number of the Type; unlike the Type's address, it is never reused (used to validate cached lookups).
+		uint64_t getSerialNumber()const						{	return serialNumber;	}
+	private:
+		static uint64_t createSerialNumber();
+		const uint64_t serialNumber;
 	//	@}
 
 	// -------------------------------------------------------------
@@ -63,6 +70,8 @@ class Type : public Object {
 		std::unordered_map<StringId,ObjRef> collectObjAttributes()const;
 
 		void copyObjAttributesTo(Object * instance);
+		//! (internal) Initialize the attributes of a new instance that is not yet accessible by others (no locking, no virtual calls).
+		void copyObjAttributesTo(AttributeContainer & instanceAttributes);
 
 		//! Used by instances of this type get the value of an inherited typeAttribute.
 		AttributeReference_t findTypeAttribute(const StringId & id);
@@ -79,10 +88,63 @@ class Type : public Object {
 		//! ---|> [Object]
 		std::unordered_map<StringId,ObjRef> collectLocalAttributes() override;
 
+		//! ---|> [Object]
+		void _traverseReferences(const std::function<void(Object*)> & visit)const override;
+		//! ---|> [Object]
+		void _releaseReferences() override;
+		//! ---|> [Object]
+		size_t _getMemoryUsage()const override;
+
+		/*! (static) Changed whenever the set of attribute names found via an existing Type may change (a Type's
+			attribute is added or released). Used to validate cached lookups; as a new Type is not yet known to
+			any cache (caches refer to a Type by its serial number), creating or destroying a Type does not change it. */
+		static uint32_t getLookupVersion()					{	return lookupVersion;	}
+
+	#if defined(ES_THREADING)
+		//! (internal) Set the value of an existing local attribute; used by Object::_assignToAccessedAttribute(...).
+		void _assignTypeAttributeValue(const StringId & id,ObjPtr value);
+	#else
+		/*! (internal) Cached information for creating instances of this type.
+			The plan refers to attributes (not to their values), so it only has to be rebuilt
+			when the lookup version changes.	*/
+		struct ConstructionPlan{
+			//! The '_constructor' attributes along the base types (and the owning types), starting with this type.
+			std::vector<std::pair<Type*,const Attribute*>> constructors;
+			uint32_t lookupVersion;
+			ConstructionPlan() : lookupVersion(0){}
+		};
+		const ConstructionPlan & _getConstructionPlan(){
+			if(constructionPlan.lookupVersion!=lookupVersion)
+				initConstructionPlan();
+			return constructionPlan;
+		}
+	#endif // ES_THREADING
+
 	private:
 		AttributeContainer attributes;
+	#if defined(ES_THREADING)
+		static std::atomic<uint32_t> lookupVersion;
+	#else
+		static uint32_t lookupVersion;
+	#endif // ES_THREADING
+		static void increaseLookupVersion()					{	if(++lookupVersion==0) ++lookupVersion;	} // 0 is never used
+	#if !defined(ES_THREADING)
+		ConstructionPlan constructionPlan;
+		void initConstructionPlan();
+	#endif // ES_THREADING
 	#if defined(ES_THREADING)
 		mutable SyncTools::FastLock attributesMutex;
+
+		/*! Immutable copy of the attributes, which is read without locking (type attributes are
+			read very often, but are rarely changed). A modification of the attributes only marks the copy
+			as outdated; a new copy is published by the next read, so that defining many attributes
+			does not copy the table each time. The old copy is deleted after all concurrent reads are finished.
+			\note publishAttributes(...) has to be called while holding the attributesMutex; the lock is released. */
+		std::atomic<AttributeContainer*> publishedAttributes;
+		std::atomic<bool> publishedAttributesOutdated;
+		void publishAttributes(SyncTools::FastLockHolder & attributesLock);
+		//! Returns the up-to-date published attributes; has to be called inside a read section.
+		AttributeContainer * getPublishedAttributes();
 	#endif // ES_THREADING
 	// @}
 
@@ -114,11 +176,24 @@ class Type : public Object {
 
 		Type * getBaseType()const					{	return baseType.get();	}
 
-		bool hasBase(const Type * type)const;
-		bool isBaseOf(const Type * type)const;
+		//! Number of base types.
+		size_t getInheritanceDepth()const			{	return ancestors.size()-1;	}
+
+		//! Returns true if @p type is this type or one of its (direct or indirect) base types. Constant time.
+		bool hasBase(const Type * type)const{
+			return type && type->getInheritanceDepth()<ancestors.size() && ancestors[type->getInheritanceDepth()]==type;
+		}
+		bool isBaseOf(const Type * type)const		{	return type && type->hasBase(this);	}
 
 	private:
 		ERef<Type> baseType;
+
+		/*! All base types ordered by their inheritance depth, followed by the type itself.
+			As the base type never changes, it is created once in the constructor.	*/
+		std::vector<const Type*> ancestors;
+		void initAncestors();
+		//! Called by the constructors to copy the base type's object attributes.
+		void inheritObjAttributes();
 	//	@}
 
 };
@@ -9,9 +9,9 @@
 #include "Bool.h"
 
 #include "../../Basics.h"
+#include "../../Utils/ObjectPool.h"
 
 #include <iostream>
-#include <stack>
 
 namespace EScript{
 
@@ -77,36 +77,17 @@ void Bool::init(EScript::Namespace & globals) {
 
 }
 //----
-static std::stack<Bool *> pool;
-#if defined(ES_THREADING)
-static SyncTools::FastLock poolMutex;
-#endif // ES_THREADING
+typedef ObjectPool<Bool> BoolPool;
 
 Bool * Bool::create(bool value){
-//static int count = 0;
-//std::cout << ++count<<" "; //2807  // (1396)
 	#ifdef ES_DEBUG_MEMORY
 	return new Bool(value);
 	#endif
-#ifdef ES_THREADING
-	auto lock = SyncTools::tryLock(poolMutex);
-	if(lock.owns_lock()){
-		if(pool.empty()){
-				lock.unlock();
-			return new Bool(false);
-		}else{
-			Bool * o = pool.top();
-			pool.pop();
-			o->value = value;
-	//        std::cout << ".";
-			return o;
-		}
-	}else{
-#endif /* ES_THREADING */
-		return new Bool(false);
-#ifdef ES_THREADING
-	}
-#endif /* ES_THREADING */
+	Bool * o = BoolPool::getThreadLocalPool().pop();
+	if(!o)
+		return new Bool(value);
+	o->value = value;
+	return o;
 }
 void Bool::release(Bool * o){
 	#ifdef ES_DEBUG_MEMORY
@@ -116,17 +97,8 @@ void Bool::release(Bool * o){
 	if(o->getType()!=getTypeObject()){
 		delete o;
 		std::cout << "Found diff BoolType\n";
-	}else{
-#ifdef ES_THREADING
-		auto lock = SyncTools::tryLock(poolMutex);
-		if(lock.owns_lock()){
-			pool.push(o);
-		}else{
-#endif /* ES_THREADING */
-			delete o;
-#ifdef ES_THREADING
-		}
-#endif /* ES_THREADING */
+	}else if(!BoolPool::getThreadLocalPool().push(o)){
+		delete o;
 	}
 }
 
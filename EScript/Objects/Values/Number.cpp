@@ -9,11 +9,11 @@
 // ---------------------------------------------------------------------------------
 #include "Number.h"
 #include "../../Basics.h"
+#include "../../Utils/ObjectPool.h"
 
 #include <cmath>
 #include <iostream>
 #include <sstream>
-#include <stack>
 
 #ifndef M_PI
 #define M_PI		3.14159265358979323846
@@ -276,37 +276,18 @@ void Number::init(EScript::Namespace & globals) {
 }
 
 //------------------------------------------------------
-static std::stack<Number *> pool;
-#if defined(ES_THREADING)
-static SyncTools::FastLock poolMutex;
-#endif // ES_THREADING
+typedef ObjectPool<Number> NumberPool;
 
 //! (static)
 Number * Number::create(double value){
-//static int count = 0;
-//std::cout << ++count<<" "; //6987 (5933)
-
 	#ifdef ES_DEBUG_MEMORY
 	return new Number(value);
 	#endif
-#ifdef ES_THREADING
-	auto lock = SyncTools::tryLock(poolMutex);
-	if(lock.owns_lock()){
-		if(pool.empty()){
-			lock.unlock();
-			return new Number(value);
-		}else{
-			Number * n = pool.top();
-			pool.pop();
-			n->setValue(value);
-			return n;
-		}
-	}else{
-#endif /* ES_THREADING */
+	Number * n = NumberPool::getThreadLocalPool().pop();
+	if(!n)
 		return new Number(value);
-#ifdef ES_THREADING
-	}
-#endif /* ES_THREADING */
+	n->setValue(value);
+	return n;
 }
 
 //! (static)
@@ -318,17 +299,8 @@ void Number::release(Number * n){
 	if(n->getType()!=getTypeObject()){
 		delete n;
 		std::cout << "Found diff NumberType\n";
-	}else{
-#ifdef ES_THREADING
-		auto lock = SyncTools::tryLock(poolMutex);
-		if(lock.owns_lock()){
-			pool.push(n);
-		}else{
-#endif /* ES_THREADING */
-			delete n;
-#ifdef ES_THREADING
-		}
-#endif /* ES_THREADING */
+	}else if(!NumberPool::getThreadLocalPool().push(n)){
+		delete n;
 	}
 }
 //----------------------------------------------------------
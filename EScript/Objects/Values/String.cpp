@@ -9,11 +9,11 @@
 #include "String.h"
 #include "../../Basics.h"
 #include "../../StdObjects.h"
+#include "../../Utils/ObjectPool.h"
 #include "../../Utils/StringUtils.h"
 
 #include <iostream>
 #include <sstream>
-#include <stack>
 
 namespace EScript{
 
@@ -263,33 +263,17 @@ void String::init(EScript::Namespace & globals) {
 }
 
 //---
-static std::stack<String *> pool;
-#if defined(ES_THREADING)
-static SyncTools::FastLock poolMutex;
-#endif // ES_THREADING
+typedef ObjectPool<String> StringPool;
 
 String * String::create(const StringData & sData){
 	#ifdef ES_DEBUG_MEMORY
 	return new String(sData);
 	#endif
-#ifdef ES_THREADING
-	auto lock = SyncTools::tryLock(poolMutex);
-	if(lock.owns_lock()){
-		if(pool.empty()){
-			lock.unlock();
-			return new String(sData);
-		}else{
-			String * o = pool.top();
-			pool.pop();
-			o->setString(sData);
-			return o;
-		}
-	}else{
-#endif /* ES_THREADING */
+	String * o = StringPool::getThreadLocalPool().pop();
+	if(!o)
 		return new String(sData);
-#ifdef ES_THREADING
-	}
-#endif /* ES_THREADING */
+	o->setString(sData);
+	return o;
 }
 void String::release(String * o){
 	#ifdef ES_DEBUG_MEMORY
@@ -300,16 +284,9 @@ void String::release(String * o){
 		delete o;
 		std::cout << "(internal) String::release: Invalid StringType\n";
 	}else{
-#ifdef ES_THREADING
-		auto lock = SyncTools::tryLock(poolMutex);
-		if(lock.owns_lock()){
-			pool.push(o);
-		}else{
-#endif /* ES_THREADING */
+		o->setString(StringData()); // release the string data
+		if(!StringPool::getThreadLocalPool().push(o))
 			delete o;
-#ifdef ES_THREADING
-		}
-#endif /* ES_THREADING */
 	}
 }
 //---
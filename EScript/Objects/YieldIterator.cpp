@@ -43,7 +43,7 @@ void YieldIterator::init(EScript::Namespace & globals) {
 
 void YieldIterator::next(Runtime & rt){
 	++counter;
-	rt.yieldNext( *this );
+	rt.tryYieldNext( *this ); // on failure, the exception remains pending
 }
 
 Object * YieldIterator::key()const{
@@ -33,6 +33,43 @@ struct _TypeIds{
 	static const internalTypeId_t TYPE_TYPE				= 0x16;
 };
 
+class Array;
+class Bool;
+class Collection;
+class FnBinder;
+class Function;
+class Identifier;
+class Number;
+class String;
+class Type;
+class UserFunction;
+class Void;
+
+/*! (internal) Maps a built-in class to the internal type ids of its instances.
+	Used by ObjPtr::castTo<...>() and ObjRef::castTo<...>() to cast objects without RTTI lookup.
+	Classes without specialization (and objects of extension types) are cast using dynamic_cast.	*/
+template<class _T> struct _InternalTypeIdOf{
+	static const bool defined = false;
+};
+
+#define ES_INTERNAL_TYPE_ID_OF(_class, _condition) \
+template<> struct _InternalTypeIdOf<_class>{ \
+	static const bool defined = true; \
+	static bool matches(const internalTypeId_t id)	{	return _condition;	} \
+};
+ES_INTERNAL_TYPE_ID_OF(Array,			id==_TypeIds::TYPE_ARRAY)
+ES_INTERNAL_TYPE_ID_OF(Bool,			id==_TypeIds::TYPE_BOOL)
+ES_INTERNAL_TYPE_ID_OF(Collection,		id==_TypeIds::TYPE_ARRAY)
+ES_INTERNAL_TYPE_ID_OF(FnBinder,		id==_TypeIds::TYPE_FN_BINDER)
+ES_INTERNAL_TYPE_ID_OF(Function,		id==_TypeIds::TYPE_FUNCTION)
+ES_INTERNAL_TYPE_ID_OF(Identifier,		id==_TypeIds::TYPE_IDENTIFIER)
+ES_INTERNAL_TYPE_ID_OF(Number,			id==_TypeIds::TYPE_NUMBER)
+ES_INTERNAL_TYPE_ID_OF(String,			id==_TypeIds::TYPE_STRING)
+ES_INTERNAL_TYPE_ID_OF(Type,			id==_TypeIds::TYPE_TYPE || id==_TypeIds::TYPE_VOID)
+ES_INTERNAL_TYPE_ID_OF(UserFunction,	id==_TypeIds::TYPE_USER_FUNCTION)
+ES_INTERNAL_TYPE_ID_OF(Void,			id==_TypeIds::TYPE_VOID)
+#undef ES_INTERNAL_TYPE_ID_OF
+
 
 }
 #endif // ES_TYPEIDS_H_INCLUDED
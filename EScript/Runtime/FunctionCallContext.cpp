@@ -14,39 +14,20 @@
 #include "../Objects/Values/Number.h"
 #include "../Objects/Values/String.h"
 #include "../Objects/Values/Void.h"
+#include "../Utils/ObjectPool.h"
+#include <iterator>
 #include <stdexcept>
 #include <sstream>
 
 namespace EScript{
 
-static std::stack<FunctionCallContext *> pool;
-
-#if defined(ES_THREADING)
-static SyncTools::FastLock poolMutex;
-#endif // ES_THREADING
+typedef ObjectPool<FunctionCallContext> FCCPool;
 
 //! (static) Factory
 FunctionCallContext * FunctionCallContext::create(ERef<UserFunction> userFunction,ObjRef _caller){
-	FunctionCallContext * fcc = nullptr;
-	{
-#ifdef ES_THREADING
-		auto lock = SyncTools::tryLock(poolMutex);
-		if(lock.owns_lock()){
-			if(pool.empty()){
-				lock.unlock();
-				fcc = new FunctionCallContext;
-			}else{
-				fcc = pool.top();
-				pool.pop();
-			}
-		}else{
-#endif /* ES_THREADING */
-			fcc = new FunctionCallContext;
-#ifdef ES_THREADING
-		}
-#endif /* ES_THREADING */
-	}
-//	fcc = new FunctionCallContext;
+	FunctionCallContext * fcc = FCCPool::getThreadLocalPool().pop();
+	if(!fcc)
+		fcc = new FunctionCallContext;
 //	assert(userFunction); //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 	fcc->init(std::move(userFunction), std::move(_caller));
 	return fcc;
@@ -55,18 +36,8 @@ FunctionCallContext * FunctionCallContext::create(ERef<UserFunction> userFunctio
 //! static
 void FunctionCallContext::release(FunctionCallContext *fcc){
 	fcc->reset();
-	{
-#ifdef ES_THREADING
-		auto lock = SyncTools::tryLock(poolMutex);
-		if(lock.owns_lock()){
-			pool.push(fcc);
-		}else{
-#endif /* ES_THREADING */
-			delete fcc;
-#ifdef ES_THREADING
-		}
-#endif /* ES_THREADING */
-	}
+	if(!FCCPool::getThreadLocalPool().push(fcc))
+		delete fcc;
 }
 
 // -------------------------------------------------------------------------
@@ -105,7 +76,21 @@ void FunctionCallContext::initCaller(const ObjPtr _caller){
 }
 
 
+void FunctionCallContext::leaveOnceStatement(const uint32_t onceStatementIdx){
+	for(auto it = enteredOnceStatements.rbegin(); it!=enteredOnceStatements.rend(); ++it){
+		if(*it == onceStatementIdx){
+			enteredOnceStatements.erase(std::next(it).base());
+			break;
+		}
+	}
+	userFunction->leaveOnceStatement(onceStatementIdx);
+}
+
 void FunctionCallContext::reset(){
+	while(!enteredOnceStatements.empty()){ // aborted @(once) statements have to be executed again
+		userFunction->abortOnceStatement(enteredOnceStatements.back());
+		enteredOnceStatements.pop_back();
+	}
 	caller = nullptr;
 	userFunction = nullptr;
 	localVariables.clear();
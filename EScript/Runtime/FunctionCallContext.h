@@ -12,6 +12,7 @@
 #include "../Objects/Callables/UserFunction.h"
 #include "../Utils/EReferenceCounter.h"
 #include "../Utils/ObjRef.h"
+#include "../Utils/ObjectPool.h"
 #include "../Consts.h"
 #include "RtValue.h"
 
@@ -22,6 +23,7 @@ namespace EScript {
 
 //! [FunctionCallContext]
 class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionCallContext> {
+		friend class ObjectPool<FunctionCallContext>;
 	public:
 		static FunctionCallContext * create(ERef<UserFunction> userFunction, ObjRef _caller);
 		static void release(FunctionCallContext *rts);
@@ -63,7 +65,7 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 
 		ObjPtr getCaller()const							{	return caller; }
 		int getCurrentLine()const{
-			return instructionCursor == getInstructions().end() ? -1 : instructionCursor->getLine();
+			return getInstructionBlock().getLine(static_cast<size_t>(instructionCursor-getInstructions().begin()));
 		}
 		size_t getExceptionHandlerPos()const			{	return exceptionHandlerPos;	}
 		const InstructionBlock & getInstructionBlock()const		{	return userFunction->getInstructionBlock();	}
@@ -88,6 +90,25 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 
 	//	-----------------------------
 
+	//! @name @(once) statements
+	// @{
+	private:
+		/*! The @(once) statements entered but not yet left by this call. If the call ends without leaving
+			them (its execution is aborted by an exception or an exit), they are reset when the context is released. */
+		std::vector<uint32_t> enteredOnceStatements;
+	public:
+		//! Returns true iff the @(once) statement has to be executed now. \see UserFunction::enterOnceStatement
+		bool enterOnceStatement(const uint32_t onceStatementIdx){
+			if(!userFunction->enterOnceStatement(onceStatementIdx))
+				return false;
+			enteredOnceStatements.push_back(onceStatementIdx);
+			return true;
+		}
+		void leaveOnceStatement(const uint32_t onceStatementIdx);
+	// @}
+
+	//	-----------------------------
+
 	//! @name Local variables
 	// @{
 	private:
@@ -155,7 +176,17 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 		void stack_pushVoid()							{	valueStack.emplace_back(nullptr);		}
 
 		size_t stack_size()const						{	return valueStack.size();	}
-		void stack_pop()								{	valueStack.pop_back();	}
+		//! Returns the entry @p depth positions below the topmost entry (0 == top) without removing it.
+		const RtValue & stack_peek(size_t depth)const{
+			if(depth>=valueStack.size())
+				throwError(STACK_EMPTY_ERROR);
+			return valueStack[valueStack.size()-1-depth];
+		}
+		void stack_pop(){
+			if(stack_empty())
+				throwError(STACK_EMPTY_ERROR);
+			valueStack.pop_back();
+		}
 		bool stack_popBool(){
 			const bool b = stack_top().toBool();
 			valueStack.pop_back();
@@ -18,6 +18,7 @@
 #include "../Objects/Callables/UserFunction.h"
 #include "../Objects/Callables/FnBinder.h"
 #include "../Objects/YieldIterator.h"
+#include "../Utils/CycleCollector.h"
 #include "../Utils/Logger.h"
 #include <algorithm>
 #include <iostream>
@@ -60,6 +61,16 @@ void Runtime::init(EScript::Namespace & globals) {
 	ES_FUN(typeObject,"_setStackSizeLimit",1,1,
 				(rt._setStackSizeLimit(parameter[0].to<uint32_t>(rt)),RtValue(nullptr)))
 
+	//!	[ESMF] Number Runtime.collectGarbage(); Returns the estimated number of released bytes.
+	ES_FUN(typeObject,"collectGarbage",0,0, static_cast<double>(CycleCollector::collect().second))
+
+	//!	[ESMF] Number Runtime.getCycleCollectionThreshold();
+	ES_FUN(typeObject,"getCycleCollectionThreshold",0,0, static_cast<uint32_t>(CycleCollector::getThreshold()))
+
+	//!	[ESMF] void Runtime.setCycleCollectionThreshold(Number); 0 disables automatic collections.
+	ES_FUN(typeObject,"setCycleCollectionThreshold",1,1,
+				(CycleCollector::setThreshold(parameter[0].to<uint32_t>(rt)),RtValue(nullptr)))
+
 	//!	[ESMF] void Runtime.disableLogCounting( );
 	ES_FUN(typeObject,"disableLogCounting",0,1, (rt.disableLogCounting(),RtValue(nullptr)))
 
@@ -133,7 +144,7 @@ void Runtime::init(EScript::Namespace & globals) {
 Runtime::Runtime() :
 		ExtObject(Runtime::getTypeObject()), 
 		internals(new RuntimeInternals(*this,
-										EScript::getSGlobals()->clone(),
+										Namespace::createLayer(EScript::getSGlobals()),
 										std::make_shared<RuntimeInternals::SharedRuntimeContext>())),
 		logger(new LoggerGroup(Logger::LOG_WARNING)){
 			
@@ -148,10 +159,10 @@ Runtime::Runtime() :
 Runtime::Runtime(const Runtime& other) :
 		ExtObject(other.getType()), 
 		internals(new RuntimeInternals(*this,
-										other.getGlobals(),
+										Namespace::createLayer(other.getGlobals()),
 										other.internals->getSharedRuntimeContext())),
 		logger(other.logger){
-	//ctor
+	declareConstant(internals->getGlobals(),"GLOBALS",internals->getGlobals());
 }
 
 //! (dtor)
@@ -173,62 +184,52 @@ bool Runtime::assertNormalState()const {
 }
 
 bool Runtime::assignToAttribute(ObjPtr obj,StringId attrId,ObjPtr value){
-	Attribute * attr = std::get<0>(obj->_accessAttribute(attrId,false));
+	Object::AttributeReference_t attrHolder( std::move(obj->_accessAttribute(attrId,false)) );
+	Attribute * attr = std::get<0>(attrHolder);
 	if( !attr )
 		return false;
 
 	if(attr->getProperties()&Attribute::ASSIGNMENT_RELEVANT_BITS){
 		if(attr->isConst()){
+#if defined(ES_THREADING)
+			std::get<1>(attrHolder).unlock();
+#endif
 			setException("Cannot assign to const attribute.");
 			return true;
 		}else if(attr->isPrivate()){
 			if( obj!=getCallingObject() ){
+#if defined(ES_THREADING)
+				std::get<1>(attrHolder).unlock();
+#endif
 				setException("Cannot assign to private attribute.");
 				return true;
 			}
 		}
 	}
-	attr->setValue(value.get());
+	Object::_assignToAccessedAttribute(attrHolder,attrId,value);
 	return true;
 }
 
 bool Runtime::checkNormalState()const				{	return internals->checkNormalState();	}
 
-ObjRef Runtime::createInstance(ERef<Type> type,const ParameterValues & _params){
+ObjRef Runtime::createInstance(ERef<Type> type,const ParameterValues & params){
 	if(!internals->checkNormalState())
 		return nullptr;
-	ParameterValues params(_params);
-	RtValue callResult(std::move(internals->startInstanceCreation(std::move(type),params)));
-	ObjRef resultObj;
-	if(callResult.isFunctionCallContext()){ // user function?
-		_CountedRef<FunctionCallContext> fcc = callResult._getFCC();
-		resultObj = internals->executeFunctionCallContext(fcc);
-	}else{
-		resultObj = callResult.getObject(); // value should be an Object...
-	}
+	std::pair<bool,ObjRef> result( tryCreateInstance(std::move(type),params) );
 	// error occured? throw an exception!
 	if(internals->isExceptionPending())
 		throw internals->fetchAndClearException().detachAndDecrease();
-
-	return resultObj;
+	return std::move(result.second);
 }
 
-ObjRef Runtime::executeFunction(ObjRef fun, ObjRef caller,const ParameterValues & _params){
+ObjRef Runtime::executeFunction(ObjRef fun, ObjRef caller,const ParameterValues & params){
 	if(!internals->checkNormalState())
 		return nullptr;
-	ParameterValues params(_params);
-	ObjRef resultObj;
-	RtValue callResult(std::move(internals->startFunctionExecution(std::move(fun),std::move(caller),params)));
-	if(callResult.isFunctionCallContext()){ // user function?
-		_CountedRef<FunctionCallContext> fcc = callResult._getFCC();
-		resultObj = internals->executeFunctionCallContext(fcc);
-	}else {
-		resultObj = callResult._toObject(); // the value should always be convertible to Object...
-	}
-	if(internals->isExceptionPending()){ // error occurred? throw an exception! callResult is undefined.
+	std::pair<bool,ObjRef> result( tryExecuteFunction(std::move(fun),std::move(caller),params) );
+	// error occurred? throw an exception!
+	if(internals->isExceptionPending())
 		throw internals->fetchAndClearException().detachAndDecrease();
-	}
-	return resultObj;
+	return std::move(result.second);
 }
 
 ObjRef Runtime::fetchAndClearExitResult()			{	return internals->fetchAndClearExitResult();	}
@@ -280,21 +281,44 @@ void Runtime::setTreatWarningsAsError(bool b){
 		logger->removeLogger("throwLogger");
 	}
 }
-void Runtime::throwException(const std::string & s,Object * obj){	internals->throwException(s,obj);	}
+std::pair<bool,ObjRef> Runtime::tryCreateInstance(ERef<Type> type,const ParameterValues & params){
+	if(!internals->checkNormalState())
+		return std::make_pair(false,nullptr);
+	RtValue callResult(std::move(internals->startInstanceCreation(std::move(type),params)));
+	ObjRef resultObj;
+	if(callResult.isFunctionCallContext()){ // user function?
+		_CountedRef<FunctionCallContext> fcc = callResult._getFCC();
+		resultObj = internals->executeFunctionCallContext(fcc);
+	}else if(internals->checkNormalState()){ // on failure, callResult is undefined.
+		resultObj = callResult.getObject(); // value should be an Object...
+	}
+	return std::make_pair(internals->checkNormalState(),std::move(resultObj));
+}
 
-void Runtime::warn(const std::string & s)	{	internals->warn(s);	}
+std::pair<bool,ObjRef> Runtime::tryExecuteFunction(ObjRef fun, ObjRef caller,const ParameterValues & params){
+	if(!internals->checkNormalState())
+		return std::make_pair(false,nullptr);
+	ObjRef resultObj;
+	RtValue callResult(std::move(internals->startFunctionExecution(std::move(fun),std::move(caller),params)));
+	if(callResult.isFunctionCallContext()){ // user function?
+		_CountedRef<FunctionCallContext> fcc = callResult._getFCC();
+		resultObj = internals->executeFunctionCallContext(fcc);
+	}else if(internals->checkNormalState()){ // on failure, callResult is undefined.
+		resultObj = callResult._toObject(); // the value should always be convertible to Object...
+	}
+	return std::make_pair(internals->checkNormalState(),std::move(resultObj));
+}
 
-void Runtime::yieldNext(YieldIterator & yIt){
+bool Runtime::tryYieldNext(YieldIterator & yIt){
 	_Ptr<FunctionCallContext> fcc = yIt.getFCC();
 	if(fcc.isNull()){
 		setException("Invalid YieldIterator");
-		return;
+		return false;
 	}
 	ObjRef result( internals->executeFunctionCallContext( fcc ) );
-	// error occurred? throw an exception!
 	if(internals->isExceptionPending()){
 		yIt.setFCC( nullptr ); // the exception rendered the fcc invalid; it must not be called again.
-		throw internals->fetchAndClearException().detachAndDecrease();
+		return false;
 	}
 	YieldIterator * newYieldIterator = result.castTo<YieldIterator>();
 
@@ -307,6 +331,17 @@ void Runtime::yieldNext(YieldIterator & yIt){
 		yIt.setFCC( nullptr );
 		yIt.setValue( result.get() );
 	}
+	return internals->checkNormalState();
+}
+
+void Runtime::throwException(const std::string & s,Object * obj){	internals->throwException(s,obj);	}
+
+void Runtime::warn(const std::string & s)	{	internals->warn(s);	}
+
+void Runtime::yieldNext(YieldIterator & yIt){
+	// error occurred? throw an exception!
+	if(!tryYieldNext(yIt) && internals->isExceptionPending())
+		throw internals->fetchAndClearException().detachAndDecrease();
 }
 std::string Runtime::getLocalStackInfo(){
 	return internals->getLocalStackInfo();
@@ -73,6 +73,18 @@ class Runtime : public ExtObject {
 		//! \note throws an exception (Object *) on failure
 		void yieldNext(YieldIterator & yIt);
 
+		/*! Non-throwing variant of executeFunction(...).
+			@return (success, result) If the call fails (or the runtime was not in its normal state), false is returned and
+				a raised exception remains pending in the runtime. Library functions can simply return in this case;
+				the exception is then handled by the calling script without unwinding the C++ stack.	*/
+		std::pair<bool,ObjRef> tryExecuteFunction(ObjRef fun, ObjRef callingObject,const ParameterValues & params);
+
+		//! Non-throwing variant of createInstance(...). \see tryExecuteFunction(...)
+		std::pair<bool,ObjRef> tryCreateInstance(ERef<Type> type,const ParameterValues & params);
+
+		//! Non-throwing variant of yieldNext(...). \see tryExecuteFunction(...)
+		bool tryYieldNext(YieldIterator & yIt);
+
 		size_t getStackSize()const;
 		size_t _getStackSizeLimit()const;
 		void _setStackSizeLimit(const size_t limit);
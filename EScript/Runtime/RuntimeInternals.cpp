@@ -9,10 +9,12 @@
 #include "RuntimeInternals.h"
 #include "FunctionCallContext.h"
 #include "../EScript.h"
+#include "../Utils/CycleCollector.h"
 #include "../Utils/StringUtils.h"
 #include "../Objects/Callables/FnBinder.h"
 #include "../Objects/Callables/Function.h"
 #include "../Objects/Exception.h"
+#include "../Objects/Identifier.h"
 #include "../Objects/YieldIterator.h"
 #include <iostream>
 #include <sstream>
@@ -92,10 +94,13 @@ bool RuntimeInternals::initSystemFunctions(){
 				ObjRef it;
 				if(	Collection * c = parameter[0].castTo<Collection>()){
 					it = c->getIterator();
-				}else if(parameter[0].castTo<YieldIterator>()){
+				}else if(parameter[0].castTo<YieldIterator>() || parameter[0].castTo<Iterator>()){
 					it = parameter[0].get();
 				}else {
-					it = std::move(callMemberFunction(rtIt.runtime,parameter[0] ,Consts::IDENTIFIER_fn_getIterator,ParameterValues()));
+					std::pair<bool,ObjRef> result( tryCallMemberFunction(rtIt.runtime,parameter[0] ,Consts::IDENTIFIER_fn_getIterator,ParameterValues()) );
+					if(!result.first)
+						return nullptr;
+					it = std::move(result.second);
 				}
 				if(it==nullptr){
 					rtIt.setException("Could not get iterator from '" + parameter[0]->toDbgString() + '\'');
@@ -117,8 +122,10 @@ bool RuntimeInternals::initSystemFunctions(){
 				for(const auto & val : *values) {
 					bool success = false;
 					for(size_t i = 0; i<constraintEnd; ++i){
-						ObjRef result = std::move(callMemberFunction(rtIt.runtime,parameter[i] ,Consts::IDENTIFIER_fn_checkConstraint,ParameterValues(val.get())));
-						if(result.toBool()) {
+						std::pair<bool,ObjRef> result( tryCallMemberFunction(rtIt.runtime,parameter[i] ,Consts::IDENTIFIER_fn_checkConstraint,ParameterValues(val.get())) );
+						if(!result.first)
+							return nullptr;
+						if(result.second.toBool()) {
 							success = true;
 							break;
 						}
@@ -196,83 +203,6 @@ bool RuntimeInternals::initSystemFunctions(){
 		};
 		systemFunctions[Consts::SYS_CALL_CASE_TEST] = _::sysCall;
 	}
-	{	// @(once)
-		/*! [ESSF] bool SYS_CALL_ONCE_ENTER( ) : pop onceMarkerId;
-			[ESSF] bool SYS_CALL_ONCE_LEAVE( ) : pop onceMarkerId;
-			if thisFn has an attribute named @p onceMarker id, true (=skip) is returned.
-			else a corresponding attribute is initialized and false (=do not skip) is returned.
-		*/
-		struct _{
-			ES_SYS_FUNCTION( sysCall_enter ) {
-				auto fcc = rtIt.getActiveFCC();
-				const StringId markerId = fcc->stack_popIdentifier();
-				
-				auto theActiveFunction =  fcc->getUserFunction();
-				Attribute* markerAttr;
-				{
-					#if defined(ES_THREADING)
-					SyncTools::FastLockHolder attrLock( theActiveFunction->attributesMutex );
-					#endif
-					
-					markerAttr = theActiveFunction->objAttributes.accessAttribute(markerId);
-					if( !markerAttr ){
-						theActiveFunction->objAttributes.setAttribute(markerId,Bool::create(false));
-						return false; // execute the once block
-					}
-				}
-				while( !markerAttr->getValue()->toBool() ){ 
-					//! wait on marker
-					//std::cout << ".";
-				}
-				return true; // already called -> skip statement
-			}
-			ES_SYS_FUNCTION( sysCall_leave ) {
-				auto fcc = rtIt.getActiveFCC();
-				const StringId markerId = fcc->stack_popIdentifier();
-				auto theActiveFunction =  fcc->getUserFunction();
-				{
-					#if defined(ES_THREADING)
-					SyncTools::FastLockHolder attrLock( theActiveFunction->attributesMutex );
-					#endif
-					auto markerAttr = theActiveFunction->objAttributes.accessAttribute(markerId);
-					Bool* markerValue = markerAttr ? markerAttr->getValue().toType<Bool>() : nullptr;
-					if(!markerValue)
-						throw std::runtime_error("RuntimeInternals: SYS_CALL_ONCE_LEAVE marker not found!");
-					markerValue->setValue(true);
-				}
-				return nullptr;
-			}
-		};
-		systemFunctions[Consts::SYS_CALL_ONCE_ENTER] = _::sysCall_enter;
-		systemFunctions[Consts::SYS_CALL_ONCE_LEAVE] = _::sysCall_leave;
-
-	}
-	{	/*! [ESSF] vale SYS_CALL_GET_STATIC_VAR( ) : pop uint32 staticVarLocation;
-		*/
-		struct _{
-			ES_SYS_FUNCTION( sysCall ) {
-				auto fcc = rtIt.getActiveFCC();
-				const uint32_t staticVarIdx = fcc->stack_popUInt32();
-				return fcc->getStaticVar(staticVarIdx);
-			}
-		};
-		systemFunctions[Consts::SYS_CALL_GET_STATIC_VAR] = _::sysCall;
-	}
-	{	/*! [ESSF] vale SYS_CALL_SET_STATIC_VAR( ) : pop uint32 staticVarLocation, pop value;
-		*/
-		struct _{
-			ES_SYS_FUNCTION( sysCall ) {
-				auto fcc = rtIt.getActiveFCC();
-				const uint32_t staticVarIdx = fcc->stack_popUInt32();
-				ObjRef value = fcc->stack_popObject();
-				if(value)
-					value = std::move(value->getRefOrCopy());
-				 fcc->setStaticVar(staticVarIdx,value.get());
-				return nullptr;
-			}
-		};
-		systemFunctions[Consts::SYS_CALL_SET_STATIC_VAR] = _::sysCall;
-	}
 	return true;
 }
 
@@ -284,6 +214,29 @@ RuntimeInternals::RuntimeInternals(Runtime & rt,ERef<Namespace> _globals,std::sh
 		stackSizeLimit(100000),globals(std::move(_globals)),normalState(true),addStackInfoToExceptions(true){
 	static bool once( initSystemFunctions() );
 	(void)once;
+	static const ObjRef initialConstraintCheck( Object::getTypeObject()->getLocalAttribute(Consts::IDENTIFIER_fn_checkConstraint).getValue() );
+	defaultConstraintCheck = initialConstraintCheck;
+#if !defined(ES_THREADING)
+	{
+		static const std::vector<std::pair<ObjRef,numberOperation_t>> initialNumberOperators = [](){
+			const std::pair<const char*,numberOperation_t> operators[] = {
+				{"+",NUMBER_ADD}, {"-",NUMBER_SUB}, {"*",NUMBER_MUL},
+				{"<",NUMBER_LESS}, {"<=",NUMBER_LESS_EQUAL}, {">",NUMBER_GREATER}, {">=",NUMBER_GREATER_EQUAL},
+				{"+=",NUMBER_ASSIGN_ADD}, {"-=",NUMBER_ASSIGN_SUB}, {"*=",NUMBER_ASSIGN_MUL},
+				{"++_pre",NUMBER_PRE_INCREMENT}, {"--_pre",NUMBER_PRE_DECREMENT},
+				{"++_post",NUMBER_POST_INCREMENT}, {"--_post",NUMBER_POST_DECREMENT}
+			};
+			std::vector<std::pair<ObjRef,numberOperation_t>> result;
+			for(const auto & op : operators){
+				ObjRef fun( Number::getTypeObject()->getLocalAttribute(StringId(op.first)).getValue() );
+				if(fun)
+					result.emplace_back(fun,op.second);
+			}
+			return result;
+		}();
+		numberOperators = initialNumberOperators;
+	}
+#endif // ES_THREADING
 	
 	{
 		#if defined(ES_THREADING)
@@ -314,7 +267,7 @@ RuntimeInternals::~RuntimeInternals(){
 // -------------------------------------------------------------
 // Function execution
 
-RtValue RuntimeInternals::sysCall(uint32_t sysFnId,ParameterValues & params){
+RtValue RuntimeInternals::sysCall(uint32_t sysFnId,const ParameterValues & params){
 	if(sysFnId>=Consts::NUM_SYS_CALLS){
 		std::ostringstream os;
 		os << "(internal) Unknown systemCall #"<<sysFnId<<'.';
@@ -324,12 +277,32 @@ RtValue RuntimeInternals::sysCall(uint32_t sysFnId,ParameterValues & params){
 	return (systemFunctions[sysFnId])(*this,params);
 }
 
+/*! Used instead of 'continue' at the end of trivial instructions (pushing constants, jumps, accessing local
+	variables, ...). These can neither cause an exception or warning nor change the active context, so the next
+	instruction is dispatched directly without checking the runtime's state.	*/
+#define ES_DISPATCH_TRIVIAL_INSTRUCTION \
+	if(fcc->getInstructionCursor()!=instructions.end()) \
+		goto dispatchInstruction; \
+	continue;
+
+/*! Used instead of ES_DISPATCH_TRIVIAL_INSTRUCTION at the end of jump instructions. A loop consisting only of
+	trivial instructions would otherwise never return to the state check at the beginning of the main loop and
+	could not be stopped by an exit-state set from another thread (e.g. when a Thread-object is destroyed).	*/
+#define ES_DISPATCH_JUMP_INSTRUCTION \
+	if(!normalState) \
+		continue; \
+	ES_DISPATCH_TRIVIAL_INSTRUCTION
+
 //! (internal)
 ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fcc){
 
 	fcc->enableStopExecutionAfterEnding();
 	pushActiveFCC(fcc);
 
+	// Reused storage for the parameter values of the calls started in this loop; the values are only
+	// accessed during startFunctionExecution(...) and are passed as ParameterValues::VIEW.
+	std::vector<ObjRef> paramBuffer;
+
 //	std::cout << fcc->getInstructions().toString()<<"\n";
 
 	while( true ){
@@ -428,6 +401,7 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 		// Instructio execution...
 		try{
 
+		dispatchInstruction:
 		const Instruction & instruction = *fcc->getInstructionCursor();
 
 //		std::cout << "---\n";
@@ -437,7 +411,8 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 
 		/* \note
 			Use a 'break' to end a case to check the state before continuing.
-			In other words: Use 'continue' only if no exception or warning may occur.*/
+			In other words: Use 'continue' only if no exception or warning may occur.
+			Trivial instructions use ES_DISPATCH_TRIVIAL_INSTRUCTION to directly continue with the next instruction.*/
 		switch(instruction.getType()){
 
 		case Instruction::I_ASSIGN_ATTRIBUTE:{
@@ -465,7 +440,7 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 						break;
 					}
 				}
-				attr->setValue(value.get());
+				Object::_assignToAccessedAttribute(attrHolder,instruction.getValue_Identifier(),value.get());
 			}else{
 				warn("Attribute not found: '"+instruction.getValue_Identifier().toString()+'\'');
 			}
@@ -479,6 +454,15 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 				$variableIndex = value	*/
 			fcc->assignToLocalVariable(instruction.getValue_uint32(), std::move(fcc->stack_popObjectValue()));
 			fcc->increaseInstructionCursor();
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
+		}
+		case Instruction::I_ASSIGN_STATIC_VARIABLE:{
+			/* 	assignStaticVariable (uint32_t) staticVariableIndex
+				------------
+				pop value
+				static[staticVariableIndex] = value	*/
+			fcc->setStaticVar(instruction.getValue_uint32(), fcc->stack_popObjectValue().get());
+			fcc->increaseInstructionCursor();
 			continue;
 		}
 
@@ -507,7 +491,7 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 #endif
 					setException("Cannot assign to const attribute '"+instruction.getValue_Identifier().toString()+"'.");
 				}else{
-					attr->setValue(value.get());
+					Object::_assignToAccessedAttribute(attrHolder,instruction.getValue_Identifier(),value.get());
 				}
 			}else{
 				warn("Attribute not found: '"+instruction.getValue_Identifier().toString()+'\'');
@@ -515,32 +499,81 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			fcc->increaseInstructionCursor();
 			break;
 		}
-		case Instruction::I_CALL:{
+		case Instruction::I_CALL:
+		case Instruction::I_TAIL_CALL:{
 			/*	call (uint32_t) numParams
 				-------------
 				pop numParams * parameters
 				pop function
 				pop object
 				call the function
-				push result (or jump to exception point)	*/
-			uint32_t numParams = instruction.getValue_uint32();
+				push result (or jump to exception point)
+
+				tailCall (uint32_t) numParams
+				-------------
+				like call, but if a user function is called, its context replaces the current one
+				(if the current context is not needed afterwards).	*/
+			uint32_t numParams = instruction.getValue_uint32Pair().first;
+#if !defined(ES_THREADING)
+			if(numParams<=1 && instruction.getValue_uint32Pair().second!=Instruction::NO_CALL_SITE_FEEDBACK
+					&& executeNumberOperation(*fcc.get(),numParams,instruction.getValue_uint32Pair().second)){
+				fcc->increaseInstructionCursor();
+				continue;
+			}
+#endif // ES_THREADING
+			if(numParams<=1){
+				const RtValue & funValue = fcc->stack_peek(numParams);
+				if(funValue.isObject() && funValue._getObject()->_getInternalTypeId()==_TypeIds::TYPE_USER_FUNCTION
+						&& executeAccessor(*fcc.get(),*static_cast<UserFunction*>(funValue._getObject()),numParams)){
+					fcc->increaseInstructionCursor();
+					continue;
+				}
+			}
 			if(numParams==Consts::DYNAMIC_PARAMETER_COUNT) // the parameter count is dynamic and lies on the stack.
 				numParams = fcc->stack_popUInt32();
 
 			//! \todo check once if the stack is big enough
 
-			ParameterValues params(numParams);
+			// the bound parameters of a FnBinder are placed directly in front of the given parameters
+			FnBinder * binder = nullptr;
+			{
+				const RtValue & funValue = fcc->stack_peek(numParams);
+				if(funValue.isObject() && funValue._getObject()->_getInternalTypeId()==_TypeIds::TYPE_FN_BINDER)
+					binder = static_cast<FnBinder*>(funValue._getObject());
+			}
+			const size_t numBoundParams = binder ? binder->getBoundParameters().size() : 0;
+			paramBuffer.resize(numBoundParams+numParams);
+			if(binder)
+				std::copy(binder->getBoundParameters().begin(),binder->getBoundParameters().end(),paramBuffer.begin());
 			for(int i = static_cast<int>(numParams)-1;i>=0;--i )
-				params.emplace(i,fcc->stack_popObjectValue());
+				paramBuffer[numBoundParams+i] = fcc->stack_popObjectValue();
 
 			ObjRef fun( std::move(fcc->stack_popObject()) );
 			ObjRef caller( std::move(fcc->stack_popObject()) );
+			if(binder){ // call the bound function directly
+				if(binder->getObject())
+					caller = binder->getObject();
+				fun = binder->getFunction(); // may release the binder
+			}
 
 			// returnValue , newUserFunctionCallContext
-			RtValue result( std::move(startFunctionExecution(fun,caller,params)) );
+			RtValue result( std::move(startFunctionExecution(std::move(fun),std::move(caller),
+											ParameterValues(paramBuffer.data(),paramBuffer.size(),ParameterValues::VIEW))) );
+			paramBuffer.clear();
 			fcc->increaseInstructionCursor();
 			if(result.isFunctionCallContext()){ // user function?
-				fcc = result._getFCC();
+				// tail call: the current context only forwards the result -> replace it by the new one.
+				// Not possible for constructors (their result is the caller) or inside a try-block.
+				if(instruction.getType() == Instruction::I_TAIL_CALL && fcc->stack_empty() && !fcc->isConstructorCall()
+						&& !fcc->isProvidingCallerAsResult() && fcc->getExceptionHandlerPos()==Instruction::INVALID_JUMP_ADDRESS){
+					const bool stopExecutionAfterEnding = fcc->isExecutionStoppedAfterEnding();
+					popActiveFCC(); // the current context is released (returned to the pool)
+					fcc = result._getFCC();
+					if(stopExecutionAfterEnding)
+						fcc->enableStopExecutionAfterEnding();
+				}else{
+					fcc = result._getFCC();
+				}
 				pushActiveFCC(fcc);
 			}else{
 				fcc->stack_pushValue(std::move(result));
@@ -548,6 +581,43 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 
 			break;
 		}
+		case Instruction::I_CHECK_CONSTRAINT:{
+			/*	checkConstraint (uint32_t) localVariableIndex
+				-------------
+				constraint = top (remains on the stack)
+				push constraint._checkConstraint( $localVariableIndex )
+				The default check (Object._checkConstraint) is performed directly without calling it.	*/
+			ObjRef constraint( std::move(fcc->stack_popObject()) );
+			fcc->stack_pushObject(constraint);
+			ObjRef value( fcc->getLocalVariable(instruction.getValue_uint32()) );
+
+			Attribute attr( std::move(constraint->getAttribute(Consts::IDENTIFIER_fn_checkConstraint)) );
+			if(!attr) {
+				warn("Attribute not found: '"+Consts::IDENTIFIER_fn_checkConstraint.toString()+'\'');
+				fcc->stack_pushVoid();
+				fcc->increaseInstructionCursor();
+				break;
+			}
+			if(attr.getValue()==defaultConstraintCheck.get() && value){
+				fcc->increaseInstructionCursor();
+				if(const Type * constraintType = constraint.castTo<const Type>()){
+					fcc->stack_pushBool( value->isA(constraintType) );
+					continue;
+				}
+				fcc->stack_pushBool( constraint->rt_isEqual(runtime,value) ); // may call a user defined '=='
+				break;
+			}
+			// user defined check
+			RtValue result( std::move(startFunctionExecution(attr.getValue(),std::move(constraint),ParameterValues(value))) );
+			fcc->increaseInstructionCursor();
+			if(result.isFunctionCallContext()){
+				fcc = result._getFCC();
+				pushActiveFCC(fcc);
+			}else{
+				fcc->stack_pushValue(std::move(result));
+			}
+			break;
+		}
 		case Instruction::I_CREATE_INSTANCE:{
 			/*	create (uint32_t) numParams
 				-------------
@@ -560,15 +630,16 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			uint32_t numParams = instruction.getValue_uint32();
 			if(numParams==Consts::DYNAMIC_PARAMETER_COUNT) // the parameter count is dynamic and lies on the stack.
 				numParams = fcc->stack_popUInt32();
-			ParameterValues params(numParams);
+			paramBuffer.resize(numParams);
 			// pop the parameters for the first constructor
 			for(int i = static_cast<int>(numParams)-1;i>=0;--i )
-				params.emplace(i,fcc->stack_popObjectValue());
+				paramBuffer[i] = fcc->stack_popObjectValue();
 
 			// pop objects whose constructor is called
 			ObjRef caller( std::move(fcc->stack_popObject()) );
 			Type* typePtr = caller.castTo<Type>();
 			if(!typePtr){
+				paramBuffer.clear();
 				setException("Can't instantiate object not of type 'Type'");
 				break;
 			}
@@ -578,7 +649,9 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			typeRef._set(typePtr);
 
 			// start instance creation
-			RtValue result(std::move(startInstanceCreation(std::move(typeRef),params)));
+			RtValue result(std::move(startInstanceCreation(std::move(typeRef),
+											ParameterValues(paramBuffer.data(),paramBuffer.size(),ParameterValues::VIEW))));
+			paramBuffer.clear();
 			fcc->increaseInstructionCursor();
 			if(result.isFunctionCallContext()){ // user constructor?
 				fcc = result._getFCC();
@@ -592,13 +665,24 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			// duplicate topmost stack entry
 			fcc->stack_dup();
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_FIND_VARIABLE:{
-			/*	if caller.Identifier -> push (caller, caller.Identifier)
+			/*	findVariable (uint32_t) identifier, (uint32_t) globalVariableCacheIndex
+				-------
+				if caller.Identifier -> push (caller, caller.Identifier)
 				else push (GLOBALS, GLOBALS.Identifier) (or nullptr,nullptr + Warning) 	*/
+			const StringId id( instruction.getValue_uint32Pair().first );
+#if !defined(ES_THREADING)
+			if(const Attribute * globalAttr = findCachedGlobalVariable(*fcc.get(),id,instruction.getValue_uint32Pair().second)){
+				fcc->stack_pushObject(globals.get());
+				fcc->stack_pushObject(globalAttr->getValue());
+				fcc->increaseInstructionCursor();
+				continue;
+			}
+#endif // ES_THREADING
 			if(fcc->getCaller()){
-				Attribute attr(std::move(fcc->getCaller()->getAttribute(instruction.getValue_Identifier())));
+				Attribute attr(std::move(fcc->getCaller()->getAttribute(id)));
 				if(attr){
 					fcc->stack_pushObject(fcc->getCaller());
 					fcc->stack_pushObject(attr.extractValue());
@@ -606,12 +690,12 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 					continue;
 				}
 			}
-			ObjRef obj(std::move(getGlobalVariable(instruction.getValue_Identifier())));
+			ObjRef obj(std::move(getGlobalVariable(id)));
 			if(obj){
 				fcc->stack_pushObject(globals.get());
 				fcc->stack_pushObject(std::move(obj));
 			}else{
-				warn("Variable '"+instruction.getValue_Identifier().toString()+"' not found: ");
+				warn("Variable '"+id.toString()+"' not found: ");
 				fcc->stack_pushVoid();
 				fcc->stack_pushVoid();
 			}
@@ -636,32 +720,81 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			break;
 		}
 		case Instruction::I_GET_VARIABLE:{
-			/*	if caller.Identifier -> push (caller.Identifier)
+			/*	getVariable (uint32_t) identifier, (uint32_t) globalVariableCacheIndex
+				-------
+				if caller.Identifier -> push (caller.Identifier)
 				else push (GLOBALS.Identifier) (or nullptr + Warning) 	*/
+			const StringId id( instruction.getValue_uint32Pair().first );
+#if !defined(ES_THREADING)
+			if(const Attribute * globalAttr = findCachedGlobalVariable(*fcc.get(),id,instruction.getValue_uint32Pair().second)){
+				fcc->stack_pushObject(globalAttr->getValue());
+				fcc->increaseInstructionCursor();
+				continue;
+			}
+#endif // ES_THREADING
 			if(fcc->getCaller()){
-				Attribute attr( std::move(fcc->getCaller()->getAttribute(instruction.getValue_Identifier())) );
+				Attribute attr( std::move(fcc->getCaller()->getAttribute(id)) );
 				if(attr){
 					fcc->stack_pushObject( std::move(attr.extractValue()) );
 					fcc->increaseInstructionCursor();
 					continue;
 				}
 			}
-			ObjRef obj(std::move(getGlobalVariable(instruction.getValue_Identifier())));
+			ObjRef obj(std::move(getGlobalVariable(id)));
 			if(obj){
 				fcc->stack_pushObject(std::move(obj));
 			}else{
-				warn("Variable not found: '"+instruction.getValue_Identifier().toString()+'\'');
+				warn("Variable not found: '"+id.toString()+'\'');
 				fcc->stack_pushVoid();
 			}
 			fcc->increaseInstructionCursor();
 			break;
 		}
+		case Instruction::I_GET_LOCAL_AND_ATTRIBUTE:
+		case Instruction::I_GET_LOCAL_ATTRIBUTE:{
+			/*	getLocalAndAttribute (uint32_t) identifier, (uint32_t) variableIndex
+				------------
+				push $variableIndex
+				push $variableIndex.Identifier (or nullptr + Warning)
+
+				getLocalAttribute (uint32_t) identifier, (uint32_t) variableIndex
+				------------
+				push $variableIndex.Identifier (or nullptr + Warning)	*/
+			const StringId id( instruction.getValue_uint32Pair().first );
+			ObjPtr obj( fcc->getLocalVariable(instruction.getValue_uint32Pair().second) );
+			if(obj.isNull())
+				obj = Void::get();
+			if(instruction.getType()==Instruction::I_GET_LOCAL_AND_ATTRIBUTE)
+				fcc->stack_pushObject(obj);
+			Attribute attr( std::move(obj->getAttribute(id)) );
+			if(!attr) {
+				warn("Attribute not found: '"+id.toString()+'\'');
+				fcc->stack_pushVoid();
+			}else if(attr.isPrivate() && fcc->getCaller()!=obj ) {
+				setException("Cannot access private attribute '"+id.toString()+"' from outside of its owning object.");
+				break;
+			}else{
+				fcc->stack_pushObject( attr.getValue() );
+				fcc->increaseInstructionCursor();
+				ES_DISPATCH_TRIVIAL_INSTRUCTION
+			}
+			fcc->increaseInstructionCursor();
+			break;
+		}
 		case Instruction::I_GET_LOCAL_VARIABLE:{
 			/* 	getLocalVariable (uint32_t) variableIndex
 				------------
 				push $variableIndex	*/
 			fcc->stack_pushObject( fcc->getLocalVariable(instruction.getValue_uint32())) ;
 			fcc->increaseInstructionCursor();
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
+		}
+		case Instruction::I_GET_STATIC_VARIABLE:{
+			/* 	getStaticVariable (uint32_t) staticVariableIndex
+				------------
+				push static[staticVariableIndex]	*/
+			fcc->stack_pushObject( fcc->getStaticVar(instruction.getValue_uint32())) ;
+			fcc->increaseInstructionCursor();
 			continue;
 		}
 		case Instruction::I_INIT_CALLER:{
@@ -719,7 +852,7 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 		}
 		case Instruction::I_JMP:{
 			fcc->setInstructionCursor( instruction.getValue_uint32() );
-			continue;
+			ES_DISPATCH_JUMP_INSTRUCTION
 		}
 		case Instruction::I_JMP_IF_SET:{
 			/* 	jmpIfSet (uint32) targetAddress
@@ -730,21 +863,21 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 				fcc->setInstructionCursor( instruction.getValue_uint32() );
 			else
 				fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_JUMP_INSTRUCTION
 		}
 		case Instruction::I_JMP_ON_TRUE:{
 			if(fcc->stack_popBool())
 				fcc->setInstructionCursor( instruction.getValue_uint32() );
 			else
 				fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_JUMP_INSTRUCTION
 		}
 		case Instruction::I_JMP_ON_FALSE:{
 			if(!fcc->stack_popBool())
 				fcc->setInstructionCursor( instruction.getValue_uint32() );
 			else
 				fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_JUMP_INSTRUCTION
 		}
 		case Instruction::I_NOT:{
 			/*	not
@@ -755,58 +888,74 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			fcc->increaseInstructionCursor();
 			continue;
 		}
+		case Instruction::I_ONCE_ENTER:{
+			/*	onceEnter (uint32_t) onceStatementIndex, (uint32_t) skipTarget
+				-------
+				if the statement has already been executed: jump to skipTarget	*/
+			const std::pair<uint32_t,uint32_t> onceIdxAndTarget = instruction.getValue_uint32Pair();
+			if(fcc->enterOnceStatement(onceIdxAndTarget.first))
+				fcc->increaseInstructionCursor();
+			else
+				fcc->setInstructionCursor( onceIdxAndTarget.second );
+			continue;
+		}
+		case Instruction::I_ONCE_LEAVE:{
+			fcc->leaveOnceStatement(instruction.getValue_uint32());
+			fcc->increaseInstructionCursor();
+			continue;
+		}
 		case Instruction::I_POP:{
 			// remove entry from stack
 			fcc->stack_pop();
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_PUSH_BOOL:{
 			fcc->stack_pushBool( instruction.getValue_Bool() );
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_PUSH_ID:{
 			fcc->stack_pushIdentifier( instruction.getValue_Identifier() );
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_PUSH_FUNCTION:{
 			fcc->stack_pushFunction( instruction.getValue_uint32() );
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_PUSH_NUMBER:{
-			fcc->stack_pushNumber( instruction.getValue_Number() );
+			fcc->stack_pushNumber( fcc->getInstructionBlock().getNumberConstant(instruction.getValue_uint32()) );
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_PUSH_STRING:{
 			fcc->stack_pushStringIndex( instruction.getValue_uint32() );
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_PUSH_UINT:{
 			fcc->stack_pushUInt32( instruction.getValue_uint32() );
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_PUSH_UNDEFINED:{
 			fcc->stack_pushUndefined();
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_PUSH_VOID:{
 			fcc->stack_pushVoid( );
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_RESET_LOCAL_VARIABLE:{
 			// $localVarId = nullptr
 //			fcc->assignToLocalVariable(instruction.getValue_uint32(), nullptr);
 			fcc->resetLocalVariable(instruction.getValue_uint32());
 			fcc->increaseInstructionCursor();
-			continue;
+			ES_DISPATCH_TRIVIAL_INSTRUCTION
 		}
 		case Instruction::I_SET_ATTRIBUTE:{
 			/*	setAttribute identifierId
@@ -839,6 +988,53 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			fcc->increaseInstructionCursor();
 			continue;
 		}
+		case Instruction::I_SWITCH:{
+			/*	switch (uint32_t) numCases, (uint32_t) switchTableIndex
+				-------------
+				if the decision value (top) has the type of the table's constants:
+					pop decision value and jump to the matching case (or jump to the table's miss address)
+				else continue with the following case test chain	*/
+			const InstructionBlock::SwitchTable & table = fcc->getInstructionBlock().getSwitchTable(instruction.getValue_uint32Pair().second);
+			const RtValue & decision = fcc->stack_peek(0);
+			uint32_t target = Instruction::INVALID_JUMP_ADDRESS;
+			switch(table.keyType){
+				case InstructionBlock::SwitchTable::NUMBER:{
+					const Number * numberObj = decision.isObject() ? dynamic_cast<const Number *>(decision._getObject()) : nullptr;
+					if(decision.isNumber() || numberObj){
+						const auto it = table.numberTargets.find(numberObj ? numberObj->getValue() : decision._getNumber());
+						target = it==table.numberTargets.end() ? table.missAddress : it->second;
+					}
+					break;
+				}
+				case InstructionBlock::SwitchTable::STRING:{
+					const String * stringObj = decision.isObject() ? dynamic_cast<const String *>(decision._getObject()) : nullptr;
+					if(decision.isLocalString() || stringObj){
+						const auto it = table.stringTargets.find(stringObj ? stringObj->getString() :
+												fcc->getInstructionBlock().getStringConstant(decision._getLocalStringIndex()).str());
+						target = it==table.stringTargets.end() ? table.missAddress : it->second;
+					}
+					break;
+				}
+				case InstructionBlock::SwitchTable::IDENTIFIER:{
+					const Identifier * idObj = decision.isObject() ? dynamic_cast<const Identifier *>(decision._getObject()) : nullptr;
+					if(decision.isIdentifier() || idObj){
+						const auto it = table.identifierTargets.find(idObj ? idObj->getId() : decision._getIdentifier());
+						target = it==table.identifierTargets.end() ? table.missAddress : it->second;
+					}
+					break;
+				}
+				default:
+					break;
+			}
+			if(target==Instruction::INVALID_JUMP_ADDRESS){ // no matching type -> use the case test chain
+				fcc->increaseInstructionCursor();
+			}else{
+				if(target!=table.missAddress) // (the instruction at the miss address pops the decision value)
+					fcc->stack_pop();
+				fcc->setInstructionCursor(target);
+			}
+			continue;
+		}
 		case Instruction::I_SYS_CALL:{
 			/*	sysCall (uint32_t,uint32_t) numParams, instruction
 				-------------
@@ -852,11 +1048,12 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 											fcc->stack_popUInt32() :
 											v.second;
 
-			ParameterValues params(numParams);
+			paramBuffer.resize(numParams);
 			for(int i = static_cast<int>(numParams)-1;i>=0;--i )
-				params.emplace(i,fcc->stack_popObjectValue());
+				paramBuffer[i] = fcc->stack_popObjectValue();
 
-			RtValue result(std::move(sysCall(funId,params)));
+			RtValue result(std::move(sysCall(funId,ParameterValues(paramBuffer.data(),paramBuffer.size(),ParameterValues::VIEW))));
+			paramBuffer.clear();
 			fcc->increaseInstructionCursor();
 			if(result.isFunctionCallContext()){ // user function?
 				fcc = result._getFCC();
@@ -904,15 +1101,27 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 	// -----------
 	return Void::get();
 }
+#undef ES_DISPATCH_JUMP_INSTRUCTION
+#undef ES_DISPATCH_TRIVIAL_INSTRUCTION
 
 //! (internal)
-RtValue RuntimeInternals::startFunctionExecution(ObjRef fun, ObjRef _callingObject,ParameterValues & pValues){
+RtValue RuntimeInternals::startFunctionExecution(ObjRef fun, ObjRef _callingObject,const ParameterValues & pValues){
 	if(fun.isNull()){
 		setException("No function to call!");
 		return RtValue();
 	}
+	if(CycleCollector::isCollectionRequested())
+		CycleCollector::collect();
 	switch( fun->_getInternalTypeId() ){
 		case _TypeIds::TYPE_USER_FUNCTION:{
+			if(!static_cast<UserFunction*>(fun.get())->isCompiled()){ // nested functions are compiled on their first call
+				try{
+					static_cast<UserFunction*>(fun.get())->compile();
+				}catch(Object * obj){
+					setException(obj);
+					return RtValue();
+				}
+			}
 			// manual move
 			UserFunction * userFunction = static_cast<UserFunction*>(fun.detach()); 
 			ERef<UserFunction> userFunRef;
@@ -1056,10 +1265,26 @@ RtValue RuntimeInternals::startFunctionExecution(ObjRef fun, ObjRef _callingObje
 
 
 //! (internal)
-RtValue RuntimeInternals::startInstanceCreation(ERef<Type> type,ParameterValues & pValues){ // add caller as parameter?
+RtValue RuntimeInternals::startInstanceCreation(ERef<Type> type,const ParameterValues & pValues){ // add caller as parameter?
 	std::vector<ObjPtr> constructors;
 
 	// collect constructors
+#if !defined(ES_THREADING)
+	const Type::ConstructionPlan & plan = type->_getConstructionPlan();
+	constructors.reserve(plan.constructors.size());
+	for(const auto & typeAndCtorAttr : plan.constructors){
+		const Attribute * ctorAttr = typeAndCtorAttr.second;
+		// first constructor must not be private -- unless it is an attribute of the calling object or of a base class (needed for factory functions!)
+		if(constructors.empty() && ctorAttr->isPrivate() && !typeAndCtorAttr.first->isBaseOf( getCallingObject().castTo<Type>() )){
+			setException("Can't instantiate Type with private _contructor.");
+			return RtValue(); // failure
+		}
+		ObjPtr fun = ctorAttr->getValue();
+		constructors.push_back(fun);
+		if(fun->_getInternalTypeId()==_TypeIds::TYPE_FUNCTION) // factory function found
+			break;
+	}
+#else
 	for(Type* typeCursor = type.get(); typeCursor; typeCursor = typeCursor->getBaseType()){
 		Object::AttributeReference_t attrHolder(typeCursor->_accessAttribute(Consts::IDENTIFIER_fn_constructor,true));
 		const Attribute * ctorAttr = std::get<0>(attrHolder);
@@ -1078,6 +1303,7 @@ RtValue RuntimeInternals::startInstanceCreation(ERef<Type> type,ParameterValues
 				break;
 		}
 	}
+#endif // ES_THREADING
 
 	// call the outermost constructor and pass the other constructor-functions by adding them to the stack
 	if(!constructors.empty()) {
@@ -1113,6 +1339,149 @@ ObjRef RuntimeInternals::getGlobalVariable(const StringId & id) {
 	return std::move(globals->getLocalAttribute(id).extractValue());
 }
 
+//! (internal)
+bool RuntimeInternals::executeAccessor(FunctionCallContext & fcc,const UserFunction & fun,uint32_t numParams){
+	if(!fun.isCompiled() || fun.getAccessorType()==UserFunction::NO_ACCESSOR || numParams!=fun.getParamCount())
+		return false;
+	const RtValue & callerValue = fcc.stack_peek(numParams+1);
+	if(!callerValue.isObject())
+		return false;
+	ObjPtr caller( callerValue._getObject() );
+	const StringId id( fun.getAccessorAttributeId() );
+
+	if(fun.getAccessorType()==UserFunction::ACCESSOR_GET){
+		// stack: caller, function -> caller.id
+		Attribute attr( std::move(caller->getAttribute(id)) );
+		if(!attr) // the function would look for a global variable or warn
+			return false;
+		ObjRef result( std::move(attr.extractValue()->getRefOrCopy()) );
+		fcc.stack_pop();
+		fcc.stack_pop();
+		fcc.stack_pushValue(RtValue(std::move(result)));
+	}else{
+		// stack: caller, function, value -> void
+		Object::AttributeReference_t attrHolder( std::move(caller->_accessAttribute(id,false)) );
+		Attribute * const attr = std::get<0>(attrHolder);
+		if(!attr || attr->isConst()) // the function would warn or throw an exception
+			return false;
+		ObjRef value( std::move(fcc.stack_popObjectValue()) );
+		Object::_assignToAccessedAttribute(attrHolder,id,value.get());
+		fcc.stack_pop();
+		fcc.stack_pop();
+		fcc.stack_pushVoid();
+	}
+	return true;
+}
+
+#if !defined(ES_THREADING)
+//! (internal)
+bool RuntimeInternals::executeNumberOperation(FunctionCallContext & fcc,uint32_t numParams,uint32_t callSiteIdx){
+	const RtValue & funValue = fcc.stack_peek(numParams);
+	if(!funValue.isObject())
+		return false;
+	UserFunction::CallSiteFeedback & feedback = fcc.getUserFunction()->_accessCallSiteFeedback(callSiteIdx);
+	if(feedback.callee!=funValue._getObject()){
+		feedback.callee = funValue._getObject();
+		feedback.numberOperation = NO_NUMBER_OPERATION;
+		for(const auto & op : numberOperators){
+			if(op.first.get()==feedback.callee){
+				feedback.numberOperation = op.second;
+				break;
+			}
+		}
+	}
+	const numberOperation_t operation = static_cast<numberOperation_t>(feedback.numberOperation);
+	if(operation==NO_NUMBER_OPERATION || (numParams==1) != (operation<NUMBER_PRE_INCREMENT))
+		return false;
+
+	// guard: the caller (and the parameter) are Numbers
+	const RtValue & callerValue = fcc.stack_peek(numParams+1);
+	Number * callerNumber = nullptr;
+	double lhs;
+	if(callerValue.isNumber()){
+		lhs = callerValue._getNumber();
+	}else if(callerValue.isObject() && callerValue._getObject()->_getInternalTypeId()==_TypeIds::TYPE_NUMBER){
+		callerNumber = static_cast<Number*>(callerValue._getObject());
+		lhs = callerNumber->toDouble();
+	}else{
+		return false;
+	}
+	double rhs = 0;
+	if(numParams==1){
+		const RtValue & paramValue = fcc.stack_peek(0);
+		if(paramValue.isNumber()){
+			rhs = paramValue._getNumber();
+		}else if(paramValue.isUint32()){
+			rhs = paramValue._getUInt32();
+		}else if(paramValue.isObject() && paramValue._getObject()->_getInternalTypeId()==_TypeIds::TYPE_NUMBER){
+			rhs = paramValue._getObject()->toDouble();
+		}else{
+			return false;
+		}
+	}
+	if(operation>=NUMBER_ASSIGN_ADD && !callerNumber) // modifying operations need a Number object
+		return false;
+	static_cast<Function*>(funValue._getObject())->increaseCallCounter();
+
+	// stack: caller, function [, parameter] -> result
+	if(numParams==1)
+		fcc.stack_pop();
+	fcc.stack_pop();
+	switch(operation){
+		case NUMBER_ADD:			fcc.stack_pop();	fcc.stack_pushNumber(lhs+rhs);		break;
+		case NUMBER_SUB:			fcc.stack_pop();	fcc.stack_pushNumber(lhs-rhs);		break;
+		case NUMBER_MUL:			fcc.stack_pop();	fcc.stack_pushNumber(lhs*rhs);		break;
+		case NUMBER_LESS:			fcc.stack_pop();	fcc.stack_pushBool(lhs<rhs);		break;
+		case NUMBER_LESS_EQUAL:		fcc.stack_pop();	fcc.stack_pushBool(lhs<=rhs);		break;
+		case NUMBER_GREATER:		fcc.stack_pop();	fcc.stack_pushBool(lhs>rhs);		break;
+		case NUMBER_GREATER_EQUAL:	fcc.stack_pop();	fcc.stack_pushBool(lhs>=rhs);		break;
+		// the modified caller remains on the stack as result
+		case NUMBER_ASSIGN_ADD:		callerNumber->setValue(lhs+rhs);	break;
+		case NUMBER_ASSIGN_SUB:		callerNumber->setValue(lhs-rhs);	break;
+		case NUMBER_ASSIGN_MUL:		callerNumber->setValue(lhs*rhs);	break;
+		case NUMBER_PRE_INCREMENT:	callerNumber->setValue(lhs+1.0);	break;
+		case NUMBER_PRE_DECREMENT:	callerNumber->setValue(lhs-1.0);	break;
+		case NUMBER_POST_INCREMENT:	callerNumber->setValue(lhs+1.0);	fcc.stack_pop();	fcc.stack_pushNumber(lhs);	break;
+		case NUMBER_POST_DECREMENT:	callerNumber->setValue(lhs-1.0);	fcc.stack_pop();	fcc.stack_pushNumber(lhs);	break;
+		default:
+			throw std::logic_error("RuntimeInternals: Invalid Number operation.");
+	}
+	return true;
+}
+
+//! (internal)
+const Attribute * RuntimeInternals::findCachedGlobalVariable(FunctionCallContext & fcc,const StringId & id,uint32_t cacheIdx){
+	UserFunction::GlobalVariableCache & cache = fcc.getUserFunction()->_accessGlobalVariableCache(cacheIdx);
+
+	// the globals' Attributes are never removed, so the cell stays valid as long as the Namespace's serial number is unchanged.
+	if(cache.namespaceSerialNumber!=globals->getSerialNumber()){
+		Attribute * cell = std::get<0>(globals->_accessAttribute(id,true));
+		if(!cell)
+			return nullptr;
+		cache.namespaceSerialNumber = globals->getSerialNumber();
+		cache.cell = cell;
+	}
+
+	Object * caller = fcc.getCaller().get();
+	if(caller){
+		// a Type's attributes are searched along its base types and its own type; this is not covered by the guard.
+		if(caller->_getInternalTypeId()==_TypeIds::TYPE_TYPE)
+			return nullptr;
+		Type * callerType = caller->getType();
+		const uint64_t callerTypeSerialNumber = callerType ? callerType->getSerialNumber() : 0;
+		if(cache.callerTypeSerialNumber!=callerTypeSerialNumber || cache.lookupVersion!=Type::getLookupVersion()){
+			if(caller->getAttribute(id))
+				return nullptr;
+			cache.callerTypeSerialNumber = callerTypeSerialNumber;
+			cache.lookupVersion = Type::getLookupVersion();
+		}else if(std::get<0>(caller->_accessAttribute(id,true))){ // shadowed by a local attribute
+			return nullptr;
+		}
+	}
+	return cache.cell;
+}
+#endif // ES_THREADING
+
 
 // -------------------------------------------------------------
 // Information
@@ -63,10 +63,10 @@ class RuntimeInternals  {
 		/*! (internal)
 			Start the execution of a function. A c++ function is executed immediatly and the result is <result,nullptr>.
 			A UserFunction produces a FunctionCallContext which still has to be executed. The result is then result.isFunctionCallContext() == true
-			\note the @p params value may be altered by this function and should not be used afterwards!	*/
-		RtValue startFunctionExecution(ObjRef fun,ObjRef callingObject,ParameterValues & params);
+			\note @p params is only accessed during this call and may be a view on a temporary buffer.	*/
+		RtValue startFunctionExecution(ObjRef fun,ObjRef callingObject,const ParameterValues & params);
 
-		RtValue startInstanceCreation(ERef<Type> type,ParameterValues & params);
+		RtValue startInstanceCreation(ERef<Type> type,const ParameterValues & params);
 
 		ObjRef executeFunctionCallContext(_Ptr<FunctionCallContext> fcc);
 
@@ -87,6 +87,34 @@ class RuntimeInternals  {
 		}
 		void popActiveFCC()										{	activeFCCs.pop_back();	}
 		void stackSizeError();
+
+		//! The native Object._checkConstraint function; constraints using it are checked without calling it.
+		ObjRef defaultConstraintCheck;
+
+		/*! If the call instruction at the fcc's cursor calls a trivial accessor function (see UserFunction::accessor_t),
+			the accessor is executed directly on the stack and true is returned. If the access would
+			cause a warning or an exception, the function has to be called normally.	*/
+		bool executeAccessor(FunctionCallContext & fcc,const UserFunction & fun,uint32_t numParams);
+
+	#if !defined(ES_THREADING)
+	public:
+		//! Operations of the built-in Number type that are executed directly at call sites.
+		enum numberOperation_t : uint8_t{
+			NO_NUMBER_OPERATION,
+			NUMBER_ADD, NUMBER_SUB, NUMBER_MUL, NUMBER_LESS, NUMBER_LESS_EQUAL, NUMBER_GREATER, NUMBER_GREATER_EQUAL,
+			NUMBER_ASSIGN_ADD, NUMBER_ASSIGN_SUB, NUMBER_ASSIGN_MUL,
+			NUMBER_PRE_INCREMENT, NUMBER_PRE_DECREMENT, NUMBER_POST_INCREMENT, NUMBER_POST_DECREMENT
+		};
+	private:
+		//! Number's original operator functions; they are referenced, so their addresses can't be reused by other objects.
+		std::vector<std::pair<ObjRef,numberOperation_t>> numberOperators;
+
+		/*! If the call instruction at the fcc's cursor calls one of Number's original operators with a Number as
+			caller (and parameter), the operation is executed directly on the stack and true is returned.
+			Otherwise (or if an operand is of another type) the function has to be called normally.
+			The called function is recorded in the call site's feedback slot.	*/
+		bool executeNumberOperation(FunctionCallContext & fcc,uint32_t numParams,uint32_t callSiteIdx);
+	#endif // ES_THREADING
 	// @}
 
 	// --------------------
@@ -98,6 +126,12 @@ class RuntimeInternals  {
 		Namespace * getGlobals()const;
 	private:
 		ERef<Namespace> globals;
+
+	#if !defined(ES_THREADING)
+		/*! Returns the global variable's Attribute if @p id does not denote an attribute of the fcc's caller and
+			the global variable exists; nullptr otherwise. The lookup is cached in the function's global variable cache. */
+		const Attribute * findCachedGlobalVariable(FunctionCallContext & fcc,const StringId & id,uint32_t cacheIdx);
+	#endif // ES_THREADING
 	// @}
 
 	// --------------------
@@ -178,7 +212,7 @@ class RuntimeInternals  {
 	private:
 		static bool initSystemFunctions();
 	public:
-		RtValue sysCall(uint32_t sysFnId,ParameterValues & params);
+		RtValue sysCall(uint32_t sysFnId,const ParameterValues & params);
 	//	@}
 };
 }
@@ -22,13 +22,12 @@ void AttributeContainer::initAttributes(Runtime & rt){
 		Attribute & attr = keyValuePair.second;
 		if(attr.isInitializable()){
 			Type * type = attr.getValue().castTo<Type>();
-			if(type){
-				ObjRef value = rt.createInstance(type,ParameterValues());
-				attr.setValue( value.get() );
-			}else{
-				ObjRef value = rt.executeFunction(attr.getValue(),nullptr,ParameterValues());
-				attr.setValue( value.get() );
-			}
+			std::pair<bool,ObjRef> result( std::move( type ?
+					rt.tryCreateInstance(type,ParameterValues()) :
+					rt.tryExecuteFunction(attr.getValue(),nullptr,ParameterValues()) ));
+			if(!result.first) // the exception remains pending
+				return;
+			attr.setValue( result.second.get() );
 		}
 	}
 }
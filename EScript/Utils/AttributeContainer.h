@@ -47,6 +47,8 @@ class AttributeContainer {
 		void initAttributes(Runtime & rt);
 		void setAttribute(const StringId & id,const Attribute & attr)	{	attributes[id] = attr;	}
 		size_t size()const												{	return attributes.size();	}
+		//! \note The Attributes keep their addresses.
+		void swap(AttributeContainer & other)							{	attributes.swap(other.attributes);	}
 
 	private:
 		attributeMap_t attributes;
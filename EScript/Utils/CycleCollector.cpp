@@ -0,0 +1,218 @@
+// CycleCollector.cpp
+// This file is part of the EScript programming language (https://github.com/EScript)
+//
+// Copyright (C) 2026 The EScript contributors
+//
+// Licensed under the MIT License. See LICENSE file for details.
+// ---------------------------------------------------------------------------------
+#include "CycleCollector.h"
+#include "../Objects/Object.h"
+
+#include <vector>
+#if defined(ES_THREADING)
+#include <mutex>
+#endif
+
+namespace EScript{
+
+#if defined(ES_THREADING)
+thread_local bool CycleCollector::collectionRequested = false;
+std::atomic<size_t> CycleCollector::threshold(CycleCollector::DEFAULT_THRESHOLD);
+#else
+bool CycleCollector::collectionRequested = false;
+size_t CycleCollector::threshold = CycleCollector::DEFAULT_THRESHOLD;
+#endif
+
+struct CycleCollector::Registry{
+	std::vector<Object*> objects;
+	size_t numNewObjects;
+#if defined(ES_THREADING)
+	std::mutex mutex;	//!< Only contended if objects are released by other threads.
+	bool orphaned;		//!< The thread has ended; the registry is deleted with its last object.
+	Registry() : numNewObjects(0),orphaned(false){}
+#else
+	Registry() : numNewObjects(0){}
+#endif
+};
+
+namespace{
+#if defined(ES_THREADING)
+typedef std::unique_lock<std::mutex> RegistryLock;
+
+//! nullptr until first used and after the thread's registry has been orphaned (objects created then are not tracked).
+thread_local CycleCollector::Registry * localRegistry = nullptr;
+thread_local bool localRegistryClosed = false;
+
+struct LocalRegistryHolder{
+	CycleCollector::Registry * registry;
+	LocalRegistryHolder() : registry(new CycleCollector::Registry){}
+	~LocalRegistryHolder(){	// the thread ends: the remaining objects may still be released by other threads
+		localRegistryClosed = true;
+		localRegistry = nullptr;
+		bool empty;
+		{
+			RegistryLock lock(registry->mutex);
+			registry->orphaned = true;
+			empty = registry->objects.empty();
+		}
+		if(empty)
+			delete registry;
+	}
+};
+
+CycleCollector::Registry * getLocalRegistry(){
+	if(!localRegistry && !localRegistryClosed){
+		static thread_local LocalRegistryHolder holder;
+		localRegistry = holder.registry;
+	}
+	return localRegistry;
+}
+#else
+CycleCollector::Registry * getLocalRegistry(){
+	static CycleCollector::Registry * registry = new CycleCollector::Registry; // never deleted, as objects may be released during static destruction
+	return registry;
+}
+#endif
+}
+
+//! (static)
+void CycleCollector::registerObject(Object * obj){
+	Registry * registry = getLocalRegistry();
+	if(!registry)
+		return;
+#if defined(ES_THREADING)
+	RegistryLock lock(registry->mutex); // uncontended unless another thread releases one of the thread's objects
+	obj->collectorRegistry = registry;
+#endif
+	obj->collectorIndex = static_cast<uint32_t>(registry->objects.size());
+	registry->objects.push_back(obj);
+	const size_t t = threshold;
+	if(t>0 && ++registry->numNewObjects >= t)
+		collectionRequested = true;
+}
+
+//! (static)
+void CycleCollector::unregisterObject(Object * obj){
+#if defined(ES_THREADING)
+	Registry * registry = obj->collectorRegistry;
+	RegistryLock lock(registry->mutex);
+#else
+	Registry * registry = getLocalRegistry();
+#endif
+	Object * last = registry->objects.back();
+	last->collectorIndex = obj->collectorIndex;
+	registry->objects[obj->collectorIndex] = last;
+	registry->objects.pop_back();
+	obj->collectorIndex = NOT_TRACKED;
+#if defined(ES_THREADING)
+	obj->collectorRegistry = nullptr;
+	if(registry->orphaned && registry->objects.empty()){
+		lock.unlock();
+		delete registry;
+	}
+#endif
+}
+
+//! (static)
+std::pair<size_t,size_t> CycleCollector::collect(){
+	collectionRequested = false;
+	Registry * registry = getLocalRegistry();
+	if(!registry)
+		return std::make_pair(0,0);
+	std::vector<ObjRef> garbage;
+	{
+	#if defined(ES_THREADING)
+		RegistryLock lock(registry->mutex); // other threads may release (and unregister) objects of the registry
+	#endif
+		registry->numNewObjects = 0;
+
+		const std::vector<Object*> & objects = registry->objects;
+		enum state_t : uint8_t { CANDIDATE, REACHABLE, EXCLUDED };
+		std::vector<state_t> states(objects.size(),EXCLUDED);
+		std::vector<int> counts(objects.size(),0);
+
+		/* Only the objects that are exclusively referenced by the current thread are candidates; their reference
+			counters and references can not be changed by other threads.
+			Objects without references are currently created or pooled; they are treated like untracked objects. */
+		for(size_t i = 0; i<objects.size(); ++i){
+			const Object * obj = objects[i];
+			if(obj->_isThreadConfined() && obj->countReferences()>0){
+				states[i] = CANDIDATE;
+				counts[i] = obj->countReferences();
+			}
+		}
+		// A child's collectorIndex may only be used if it is tracked by this registry (checked first).
+	#if defined(ES_THREADING)
+		const auto isCandidate = [&](const Object * child){
+			return child && child->collectorRegistry==registry && states[child->collectorIndex]==CANDIDATE;
+		};
+	#else
+		const auto isCandidate = [&](const Object * child){
+			return child && child->collectorIndex!=NOT_TRACKED && states[child->collectorIndex]==CANDIDATE;
+		};
+	#endif
+		// subtract the references among the candidates
+		for(size_t i = 0; i<objects.size(); ++i){
+			if(states[i]==CANDIDATE){
+				objects[i]->_traverseReferences([&](Object * child){
+					if(isCandidate(child))
+						--counts[child->collectorIndex];
+				});
+			}
+		}
+		// mark all candidates reachable from a candidate with external references
+		std::vector<Object*> pending;
+		for(size_t i = 0; i<objects.size(); ++i){
+			if(states[i]==CANDIDATE && counts[i]>0){
+				states[i] = REACHABLE;
+				pending.push_back(objects[i]);
+			}
+		}
+		while(!pending.empty()){
+			Object * obj = pending.back();
+			pending.pop_back();
+			obj->_traverseReferences([&](Object * child){
+				if(isCandidate(child)){
+					states[child->collectorIndex] = REACHABLE;
+					pending.push_back(child);
+				}
+			});
+		}
+		for(size_t i = 0; i<objects.size(); ++i){
+			if(states[i]==CANDIDATE)
+				garbage.emplace_back(objects[i]);
+		}
+	}
+	// The garbage is kept alive until all cycles are broken.
+	size_t numBytes = 0;
+	for(auto & obj : garbage)
+		numBytes += obj->_getMemoryUsage();
+	for(auto & obj : garbage)
+		obj->_releaseReferences();
+	const size_t numObjects = garbage.size();
+	garbage.clear();
+	return std::make_pair(numObjects,numBytes);
+}
+
+//! (static)
+size_t CycleCollector::countTrackedObjects(){
+	Registry * registry = getLocalRegistry();
+	if(!registry)
+		return 0;
+#if defined(ES_THREADING)
+	RegistryLock lock(registry->mutex);
+#endif
+	return registry->objects.size();
+}
+
+//! (static)
+void CycleCollector::setThreshold(size_t numObjects){
+	threshold = numObjects;
+}
+
+//! (static)
+size_t CycleCollector::getThreshold(){
+	return threshold;
+}
+
+}
@@ -0,0 +1,67 @@
+// CycleCollector.h
+// This file is part of the EScript programming language (https://github.com/EScript)
+//
+// Copyright (C) 2026 The EScript contributors
+//
+// Licensed under the MIT License. See LICENSE file for details.
+// ---------------------------------------------------------------------------------
+#ifndef ES_CYCLE_COLLECTOR_H_
+#define ES_CYCLE_COLLECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#if defined(ES_THREADING)
+#include <atomic>
+#endif
+
+namespace EScript {
+class Object;
+
+/*! Collector for reference cycles that can not be released by reference counting.
+	Objects that may be part of a cycle (ExtObjects, Types, Arrays, Maps, FnBinders, ...) are tracked
+	by the thread that creates them. A collection (synchronous trial deletion) subtracts the references
+	among the tracked objects from their reference counters; objects that are not reachable from an
+	object with remaining (external) references are garbage. Their references are released, which breaks the cycles.
+	\note A collection only considers the objects tracked by the calling thread that are not referenced
+		by other threads. Only the calling thread can access these objects (and their reference counters),
+		so they are inspected without locking.	*/
+class CycleCollector {
+	public:
+		static const uint32_t NOT_TRACKED = 0xffffffff;
+		static const size_t DEFAULT_THRESHOLD = 10000;
+
+		//! The objects tracked by one thread.
+		struct Registry;
+
+		//! (internal) Called by the constructors of objects that may be part of reference cycles.
+		static void registerObject(Object * obj);
+		//! (internal) Called by Object's destructor for tracked objects.
+		static void unregisterObject(Object * obj);
+
+		/*! Release all objects tracked by the calling thread that are only referenced by other unreachable objects.
+			@return (number of released objects, estimated number of released bytes)	*/
+		static std::pair<size_t,size_t> collect();
+
+		//! Number of objects tracked by the calling thread.
+		static size_t countTrackedObjects();
+
+		/*! If > 0, a collection is requested after @p numObjects new objects have been tracked by a thread
+			(default: DEFAULT_THRESHOLD).	*/
+		static void setThreshold(size_t numObjects);
+		static size_t getThreshold();
+
+		//! The Runtime performs a requested collection before the next function call of the thread.
+		static bool isCollectionRequested()	{	return collectionRequested;	}
+	private:
+#if defined(ES_THREADING)
+		static thread_local bool collectionRequested;
+		static std::atomic<size_t> threshold;
+#else
+		static bool collectionRequested;
+		static size_t threshold;
+#endif
+};
+}
+
+#endif // ES_CYCLE_COLLECTOR_H_
@@ -12,6 +12,7 @@
 #include <cstddef>
 #if defined(ES_THREADING)
 #include "SyncTools.h"
+#include <vector>
 #endif
 
 namespace EScript {
@@ -21,29 +22,205 @@ struct _DefaultReleaseHandler{
 	static void release(Obj_t * t)	{	delete t;	}
 };
 
+#if defined(ES_THREADING)
+namespace _Internals{
+/*! (internal) Per thread and counted type: Objects owned by the thread whose shared counter became
+	negative (i.e. a reference created by the owner has been released by another thread).
+	Their counters are merged by the owner thread. \note The queues are never deleted, so that their
+	addresses can be used as unique thread ids.	*/
+template<class Obj_t>
+struct BiasedRefQueue{
+	std::mutex mutex;
+	std::vector<Obj_t*> objects;
+	SyncTools::atomicBool pending;
+	bool alive;
+	BiasedRefQueue() : pending(false), alive(true){}
+};
+}
+#endif
+
 /*! (Non virtual) base class for reference counting.
 	@p Obj_t  Should be the new class itself.
 	@p ObjReleaseHandler_T	A class which has the function 'static void release(Ojb_t *)'
-		for releasing (deleting or storing) counted objects.	*/
+		for releasing (deleting or storing) counted objects.
+	If ES_THREADING is defined, biased reference counting is used: The thread that created an object
+	counts its references non-atomically; all other threads use an atomic shared counter. The two
+	counters are merged when the owner's counter drops to zero, or when the shared counter becomes
+	negative (then the owner thread merges them on its next reference release).	*/
 template<class Obj_t, class ObjReleaseHandler_T = _DefaultReleaseHandler<Obj_t> >
 class EReferenceCounter {
 #if defined(ES_THREADING)
-		SyncTools::atomicInt refCounter;
+		typedef _Internals::BiasedRefQueue<Obj_t> queue_t;
+
+		//! The shared counter stores the count in the upper bits and these flags in the lower two bits.
+		enum sharedCounterBits_t{
+			SHARED_MERGED = 1,	//!< The owner's counter has been merged; only the shared counter is used.
+			SHARED_QUEUED = 2,	//!< The object is stored in the owner's queue.
+			SHARED_ONE = 4
+		};
+		queue_t * ownerQueue;	//!< Queue of the owner thread; only changed while there are no references.
+		bool ownerMerged;		//!< (owner thread only) The owner thread has to use the shared counter.
+		int biasedCounter;		//!< (owner thread only)
+		SyncTools::atomicInt sharedCounter;
+
+		//! nullptr until first used and after the thread's queue has been closed.
+		static thread_local queue_t * localQueue;
+		static thread_local bool localQueueClosed;
+
+		struct LocalQueueHolder{
+			queue_t * queue;
+			LocalQueueHolder() : queue(new queue_t){}
+			~LocalQueueHolder(){	// the thread ends: objects queued from now on are merged by the releasing thread
+				localQueueClosed = true;
+				localQueue = nullptr;
+				std::vector<Obj_t*> objects;
+				{
+					std::lock_guard<std::mutex> lock(queue->mutex);
+					queue->alive = false;
+					objects.swap(queue->objects);
+				}
+				for(auto & o : objects)
+					merge(o);
+			}
+		};
+		static queue_t * getLocalQueue(){
+			if(!localQueue && !localQueueClosed){
+				static thread_local LocalQueueHolder holder;
+				localQueue = holder.queue;
+			}
+			return localQueue;
+		}
+		void initCounters(){
+			ownerQueue = getLocalQueue();
+			ownerMerged = (ownerQueue==nullptr);
+			biasedCounter = 0;
+			sharedCounter.store(ownerMerged ? SHARED_MERGED : 0,std::memory_order_relaxed);
+		}
+		inline bool isOwnedByLocalThread()const{
+			return ownerQueue==localQueue && !ownerMerged;
+		}
+
+		//! Add the owner's count to the shared counter; the caller needs exclusive access to the owner's counter.
+		static void merge(Obj_t * o){
+			const int count = o->biasedCounter;
+			o->biasedCounter = 0;
+			o->ownerMerged = true;
+			int current = o->sharedCounter.load(std::memory_order_relaxed);
+			int desired;
+			do{
+				desired = ((current + count*SHARED_ONE) | SHARED_MERGED) & ~SHARED_QUEUED;
+			}while(!o->sharedCounter.compare_exchange_weak(current,desired,std::memory_order_acq_rel));
+			if(desired < SHARED_ONE)
+				release(o);
+		}
+		static void processQueue(queue_t * queue){
+			std::vector<Obj_t*> objects;
+			{
+				std::lock_guard<std::mutex> lock(queue->mutex);
+				queue->pending.store(false,std::memory_order_relaxed);
+				objects.swap(queue->objects);
+			}
+			for(auto & o : objects)
+				merge(o);
+		}
+		static void enqueue(Obj_t * o){
+			queue_t * queue = o->ownerQueue;
+			{
+				std::lock_guard<std::mutex> lock(queue->mutex);
+				if(queue->alive){
+					queue->objects.push_back(o);
+					queue->pending.store(true,std::memory_order_relaxed);
+					return;
+				}
+			}
+			merge(o); // the owner thread has ended
+		}
+		static void release(Obj_t * o){
+			o->initCounters(); // pooled objects are reused by the releasing thread
+			ObjReleaseHandler_T::release(o);
+		}
 #else
 		int refCounter;
 #endif
-		
+
 	public:
 		//! Default constructor
+#if defined(ES_THREADING)
+		EReferenceCounter()	{	initCounters();	}
+#else
 		EReferenceCounter():refCounter(0){}
+#endif
 		EReferenceCounter(const EReferenceCounter & ) = delete;
 		EReferenceCounter(EReferenceCounter && ) = delete;
 
 		//! Default destructor
 		~EReferenceCounter(){}
 
+#if defined(ES_THREADING)
+		//! Return the current number of references to this object (only exact if called by the owner thread).
+		int countReferences()const	{
+			return (isOwnedByLocalThread() ? biasedCounter : 0) +
+					sharedCounter.load(std::memory_order_relaxed)/SHARED_ONE;
+		}
+		//! Returns true iff all references to the object are counted by the current thread.
+		bool _isThreadConfined()const	{
+			return isOwnedByLocalThread() && sharedCounter.load(std::memory_order_relaxed)==0;
+		}
+
+		//! Increase the reference counter of @p o.
+		static inline void addReference(Obj_t * o)	{
+			if(o==nullptr)
+				return;
+			if(o->isOwnedByLocalThread())
+				++o->biasedCounter;
+			else
+				o->sharedCounter.fetch_add(SHARED_ONE,std::memory_order_relaxed);
+		}
+
+		//! Decrease the reference counter of @p o. If the counter is <= 0, the object is released.
+		static inline void removeReference(Obj_t * o){
+			if(o==nullptr)
+				return;
+			if(o->isOwnedByLocalThread()){
+				if((--o->biasedCounter)==0){
+					queue_t * const queue = localQueue;
+					o->ownerMerged = true;
+					const int old = o->sharedCounter.fetch_or(SHARED_MERGED,std::memory_order_acq_rel);
+					if(old < SHARED_ONE && (old&SHARED_QUEUED)==0)
+						release(o);
+					if(queue->pending.load(std::memory_order_relaxed))
+						processQueue(queue);
+				}
+				return;
+			}
+			int current = o->sharedCounter.load(std::memory_order_relaxed);
+			int desired;
+			do{
+				desired = current - SHARED_ONE;
+				if( (desired&(SHARED_MERGED|SHARED_QUEUED))==0 && desired<0 )
+					desired |= SHARED_QUEUED;
+			}while(!o->sharedCounter.compare_exchange_weak(current,desired,std::memory_order_acq_rel));
+			if(desired&SHARED_MERGED){
+				if(desired < SHARED_ONE && (desired&SHARED_QUEUED)==0)
+					release(o);
+			}else if( (desired&SHARED_QUEUED) && (current&SHARED_QUEUED)==0 ){
+				enqueue(o);
+			}
+		}
+		//! Decrease the reference counter of @p o. The object is never released.
+		static inline void decreaseReference(Obj_t * o){
+			if(o==nullptr)
+				return;
+			if(o->isOwnedByLocalThread())
+				--o->biasedCounter;
+			else
+				o->sharedCounter.fetch_sub(SHARED_ONE,std::memory_order_relaxed);
+		}
+#else
 		//! Return the current number of references to this object.
 		inline int countReferences()const			{	return refCounter;	}
+		//! Returns true iff all references to the object are counted by the current thread.
+		bool _isThreadConfined()const				{	return true;	}
 
 		//! Increase the reference counter of @p o.
 		static inline void addReference(Obj_t * o)	{
@@ -61,9 +238,17 @@ class EReferenceCounter {
 			if(o!=nullptr)
 				--o->refCounter;
 		}
+#endif
 		EReferenceCounter & operator=(const EReferenceCounter &) = delete;
 		EReferenceCounter & operator=(EReferenceCounter &&) = delete;
 };
 
+#if defined(ES_THREADING)
+template<class Obj_t, class ObjReleaseHandler_T>
+thread_local typename EReferenceCounter<Obj_t,ObjReleaseHandler_T>::queue_t * EReferenceCounter<Obj_t,ObjReleaseHandler_T>::localQueue = nullptr;
+template<class Obj_t, class ObjReleaseHandler_T>
+thread_local bool EReferenceCounter<Obj_t,ObjReleaseHandler_T>::localQueueClosed = false;
+#endif
+
 }
 #endif // EREFERENCECOUNTER_H
@@ -14,7 +14,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <ios>
+#include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,7 +30,6 @@ namespace IO{
 	all operations to certain folders).
 	\todo
 		 - (?) add flush()
-		 - add streaming support
 	*/
 class AbstractFileSystemHandler  {
 protected:
@@ -78,6 +79,13 @@ public:
 	virtual StringData loadFile(const std::string &){
 		throw std::ios_base::failure("unsupported operation");
 	}
+	/*!	---o
+	 * Open a stream for reading and/or writing the file's content.
+	 * @param mode		Combination of std::ios_base::in, out, app and trunc.
+	 * @throw std::ios_base::failure on failure.	*/
+	virtual std::unique_ptr<std::iostream> openStream(const std::string &, std::ios_base::openmode /*mode*/){
+		throw std::ios_base::failure("unsupported operation");
+	}
 	//! ---o
 	virtual void saveFile(const std::string &, const std::string & /*data*/, bool /*overwrite*/){
 		throw std::ios_base::failure("unsupported operation");
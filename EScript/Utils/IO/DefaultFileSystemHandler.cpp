@@ -7,6 +7,7 @@
 // Licensed under the MIT License. See LICENSE file for details.
 // ---------------------------------------------------------------------------------
 #include "DefaultFileSystemHandler.h"
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -23,6 +24,13 @@ namespace EScript{
 
 namespace IO{
 
+//! ---|> AbstractFileSystemHandler
+void DefaultFileSystemHandler::deleteFile(const std::string & filename){
+	if(getEntryType(filename)!=TYPE_FILE || std::remove(filename.c_str())!=0)
+		throw std::ios_base::failure(std::string("Could not delete file: '"+filename+'\''));
+}
+
+//! ---|> AbstractFileSystemHandler
 std::vector<std::string> DefaultFileSystemHandler::dir(const std::string & dirname, uint8_t flags) {
 
 	DIR *directoryHandle = opendir(dirname.c_str());
@@ -68,12 +76,19 @@ StringData DefaultFileSystemHandler::loadFile(const std::string & filename){
 		return StringData();
 	}
 
-	char *pBuffer = new char[size+1];
-	inputFile.read( pBuffer, size );
+	// read directly into the string's buffer, which is then taken over by the StringData
+	std::string content(size,'\0');
+	inputFile.read( &content[0], size );
 	inputFile.close();
-	StringData result(pBuffer,size);
-	delete [] pBuffer;
-	return result;
+	return StringData(std::move(content));
+}
+
+//! ---|> AbstractFileSystemHandler
+std::unique_ptr<std::iostream> DefaultFileSystemHandler::openStream(const std::string & filename, std::ios_base::openmode mode){
+	std::unique_ptr<std::iostream> stream(new std::fstream(filename.c_str(), mode | std::ios::binary));
+	if( stream->fail())
+		throw std::ios_base::failure(std::string("Could not open file: '"+filename+'\''));
+	return stream;
 }
 
 //! ---|> AbstractFileSystemHandler
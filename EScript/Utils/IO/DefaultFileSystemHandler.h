@@ -21,6 +21,9 @@ public:
 	DefaultFileSystemHandler(){}
 	virtual ~DefaultFileSystemHandler(){}
 
+	//! ---|> AbstractFileSystemHandler
+	void deleteFile(const std::string &) override;
+
 	//! ---|> AbstractFileSystemHandler
 	std::vector<std::string> dir(const std::string &, uint8_t) override;
 
@@ -30,6 +33,9 @@ public:
 	//! ---|> AbstractFileSystemHandler
 	StringData loadFile(const std::string &) override;
 
+	//! ---|> AbstractFileSystemHandler
+	std::unique_ptr<std::iostream> openStream(const std::string &, std::ios_base::openmode) override;
+
 	//! ---|> AbstractFileSystemHandler
 	void saveFile(const std::string &, const std::string & /*data*/, bool /*overwrite*/) override;
 };
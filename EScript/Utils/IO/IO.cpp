@@ -37,6 +37,16 @@ void IO::saveFile(const std::string & filename,const std::string & content,bool
 	getFileSystemHandler()->saveFile(filename,content,overwrite);
 }
 
+//! (static)
+void IO::deleteFile(const std::string & filename){
+	getFileSystemHandler()->deleteFile(filename);
+}
+
+//! (static)
+std::unique_ptr<std::iostream> IO::openStream(const std::string & filename, std::ios_base::openmode mode){
+	return getFileSystemHandler()->openStream(filename,mode);
+}
+
 //! (static)
 uint32_t IO::getFileMTime(const std::string& filename) {
 	return getFileSystemHandler()->getFileMTime(filename);
@@ -14,6 +14,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <ios>
+#include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,6 +31,14 @@ AbstractFileSystemHandler * getFileSystemHandler();
 StringData loadFile(const std::string & filename);
 void saveFile(const std::string & filename,const std::string & content,bool overwrite=true);
 
+//! @throw std::ios_base::failure on failure.
+void deleteFile(const std::string & filename);
+
+/*!	Open a file for streamed reading and/or writing.
+ *	@param mode		Combination of std::ios_base::in, out, app and trunc.
+ *	@throw std::ios_base::failure on failure.	*/
+std::unique_ptr<std::iostream> openStream(const std::string & filename, std::ios_base::openmode mode);
+
 /*! @param filename
  *	@return file modification Time	*/
 uint32_t getFileMTime(const std::string& filename);
@@ -19,6 +19,8 @@ class Object;
  * Array of fixed size for EScript::Objects (via ObjRef or ObjPtr).
  * \note This array is especially optimized for sizes of < 3 (typical number of parameters). For those sizes,
  *	the benchmark indicates that it is a good deal faster than a std::vector.
+ * \note An array created as view (_ObjArray(values,count,VIEW)) does not own its values; it is used by the
+ *	runtime to pass parameters from a reused buffer without copying them.
  */
 template<typename _T>
 class	_ObjArray{
@@ -27,10 +29,12 @@ public:
 	typedef _T*			iterator;
 	typedef const _T*		const_iterator;
 	typedef std::size_t	size_type;
+	enum view_t{	VIEW	};
 
 	// data
 private:
 	size_type paramCount;
+	bool isView;
 	_T internalParams[2];
 	_T * params;
 
@@ -38,28 +42,31 @@ private:
 public:
 	typedef _ObjArray<_T> thisObj_t;
 
-	_ObjArray() : paramCount(0),params(nullptr){
+	_ObjArray() : paramCount(0),isView(false),params(nullptr){
 	}
-	_ObjArray(ObjPtr p1) : paramCount(1),params(internalParams){
+	_ObjArray(ObjPtr p1) : paramCount(1),isView(false),params(internalParams){
 		params[0]=p1;
 	}
-	_ObjArray(ObjPtr p1,ObjPtr p2) : paramCount(2),params(internalParams){
+	_ObjArray(ObjPtr p1,ObjPtr p2) : paramCount(2),isView(false),params(internalParams){
 		params[0]=p1,	params[1]=p2;
 	}
-	_ObjArray(ObjPtr p1,ObjPtr p2,ObjPtr p3) : paramCount(3),params(new _T[3]){
+	_ObjArray(ObjPtr p1,ObjPtr p2,ObjPtr p3) : paramCount(3),isView(false),params(new _T[3]){
 		params[0]=p1,	params[1]=p2,	params[2]=p3;
 	}
-	_ObjArray(ObjPtr p1,ObjPtr p2,ObjPtr p3,ObjPtr p4) : paramCount(4),params(new _T[4]){
+	_ObjArray(ObjPtr p1,ObjPtr p2,ObjPtr p3,ObjPtr p4) : paramCount(4),isView(false),params(new _T[4]){
 		params[0]=p1,	params[1]=p2,	params[2]=p3,	params[3]=p4;
 	}
-	explicit _ObjArray(size_type _paramCount) : paramCount(_paramCount),params(paramCount>2 ? new _T[paramCount] : internalParams){
+	explicit _ObjArray(size_type _paramCount) : paramCount(_paramCount),isView(false),params(paramCount>2 ? new _T[paramCount] : internalParams){
 	}
-	explicit _ObjArray(const _ObjArray & other) : paramCount(other.paramCount),params(paramCount>2 ? new _T[paramCount] : internalParams){
+	explicit _ObjArray(const _ObjArray & other) : paramCount(other.paramCount),isView(false),params(paramCount>2 ? new _T[paramCount] : internalParams){
 		if(paramCount>0)
 			std::copy(other.begin(),other.end(),begin());
 	}
+	//! Non-owning view on @p _paramCount values; the values have to outlive the array.
+	_ObjArray(_T * values,size_type _paramCount,view_t) : paramCount(_paramCount),isView(true),params(values){
+	}
 
-	~_ObjArray()								{	if(paramCount > 2) delete [] params; }
+	~_ObjArray()								{	if(paramCount > 2 && !isView) delete [] params; }
 	//! \note no range check is performed.
 	inline void set(size_type i,ObjPtr v)		{	params[i]=v; }
 	inline void emplace(size_type i,ObjRef && v){	params[i] = std::move(v); }
@@ -12,8 +12,35 @@
 #include <cstddef>
 #include <string>
 #include "ConversionBasics.h"
+#include "../Objects/typeIds.h"
+#include <type_traits>
 
 namespace EScript {
+class Object;
+
+namespace _Internals{
+template<class _T2,class _T>
+inline _T2 * castObject(_T * obj,std::false_type)	{	return dynamic_cast<_T2*>(obj);	}
+
+template<class _T2,class _T>
+inline _T2 * castObject(_T * obj,std::true_type){
+	if(!obj)
+		return nullptr;
+	const internalTypeId_t typeId = obj->_getInternalTypeId();
+	if(typeId == _TypeIds::TYPE_UNKNOWN) // extension type; may still be derived from the target type
+		return dynamic_cast<_T2*>(obj);
+	return _InternalTypeIdOf<_T2>::matches(typeId) ? static_cast<_T2*>(obj) : nullptr;
+}
+
+/*! (internal) dynamic_cast replacement for Object-pointers: If the target type is a built-in type,
+	the cast is resolved using the object's internal type id. \see _InternalTypeIdOf	*/
+template<class _T2,class _T>
+inline _T2 * castObject(_T * obj){
+	return castObject<_T2>(obj,std::integral_constant<bool,
+			std::is_same<typename std::remove_const<_T>::type,Object>::value && _InternalTypeIdOf<_T2>::defined>());
+}
+}
+
 template<class _T> class _Ptr;
 
 //! Simple (counted) reference to use with EReferenceCounter
@@ -127,8 +154,8 @@ class _Ptr  {
 
 
 		//! Tries to convert object to given Type; returns nullptr if object is nullptr or not of given type.
-		template <class _T2> _T2 * toType()const	{	return isNull()?nullptr:dynamic_cast<_T2*>(obj);	}
-		template <class _T2> _T2 * castTo()const	{	return dynamic_cast<_T2*>(this->get());	}
+		template <class _T2> _T2 * toType()const	{	return isNull()?nullptr:_Internals::castObject<_T2>(obj);	}
+		template <class _T2> _T2 * castTo()const	{	return _Internals::castObject<_T2>(this->get());	}
 
 	//! @name Information
 	// @{
@@ -222,8 +249,8 @@ class ERef : public _CountedRef<_T> {
 		}
 
 		//! Tries to convert object to given Type; returns nullptr if object is nullptr or not of given type.
-		template <class _T2> _T2 * toType()const	{	return this->isNull()?nullptr : dynamic_cast<_T2*>(this->get());	}
-		template <class _T2> _T2 * castTo()const	{	return dynamic_cast<_T2*>(this->get());	}
+		template <class _T2> _T2 * toType()const	{	return this->isNull()?nullptr : _Internals::castObject<_T2>(this->get());	}
+		template <class _T2> _T2 * castTo()const	{	return _Internals::castObject<_T2>(this->get());	}
 };
 
 /*! Weak smart pointer for referencing Objects (without implicit handling of the reference counter!)
@@ -311,10 +338,9 @@ class EPtr{
 		}
 
 		//! Tries to convert object to given Type; returns nullptr if object is nullptr or not of given type.
-		template <class _T2> _T2 * toType()const	{	return isNull()?nullptr:dynamic_cast<_T2*>(obj);	}
-		template <class _T2> _T2 * castTo()const	{	return dynamic_cast<_T2*>(this->get());	}
+		template <class _T2> _T2 * toType()const	{	return isNull()?nullptr:_Internals::castObject<_T2>(obj);	}
+		template <class _T2> _T2 * castTo()const	{	return _Internals::castObject<_T2>(this->get());	}
 };
-class Object;
 
 typedef ERef<Object> ObjRef;
 typedef EPtr<Object> ObjPtr;
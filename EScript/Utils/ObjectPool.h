@@ -0,0 +1,53 @@
+// ObjectPool.h
+// This file is part of the EScript programming language (https://github.com/EScript)
+//
+// Copyright (C) 2026 The EScript contributors
+//
+// Licensed under the MIT License. See LICENSE file for details.
+// ---------------------------------------------------------------------------------
+#ifndef ES_OBJECT_POOL_H_
+#define ES_OBJECT_POOL_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace EScript {
+
+/*! Free list used for recycling short-lived objects (Numbers, Strings, FunctionCallContexts, ...).
+	Every thread has its own pool, so no locking is necessary. An object may be released by
+	another thread than the one that created it. The pooled objects are deleted when the thread ends.
+	\note The pooled type's destructor has to be accessible for the pool.	*/
+template<typename _T,std::size_t _maxSize = 1024>
+class ObjectPool{
+		std::vector<_T*> objects;
+
+		ObjectPool()	{	objects.reserve(64);	}
+		~ObjectPool(){
+			for(auto & obj : objects)
+				delete obj;
+		}
+	public:
+		static ObjectPool & getThreadLocalPool(){
+			static thread_local ObjectPool pool;
+			return pool;
+		}
+
+		//! Returns a pooled object or nullptr if the pool is empty.
+		_T * pop(){
+			if(objects.empty())
+				return nullptr;
+			_T * obj = objects.back();
+			objects.pop_back();
+			return obj;
+		}
+		//! Store the object in the pool. Returns false if the pool is full; the object has then to be deleted by the caller.
+		bool push(_T * obj){
+			if(objects.size()>=_maxSize)
+				return false;
+			objects.push_back(obj);
+			return true;
+		}
+};
+
+}
+#endif // ES_OBJECT_POOL_H_
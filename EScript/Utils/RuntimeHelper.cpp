@@ -10,10 +10,12 @@
 
 #include "../Objects/Callables/UserFunction.h"
 #include "../Objects/Exception.h"
+#include "../Compiler/CodeImage.h"
 #include "../Compiler/Compiler.h"
 #include "../Runtime/Runtime.h"
 #include "IO/IO.h"
 #include "../Consts.h"
+#include <algorithm>
 #include <sstream>
 
 namespace EScript {
@@ -63,6 +65,29 @@ ObjRef callFunction(Runtime & runtime, ObjRef funObj, const ParameterValues & pa
 	return std::move(runtime.executeFunction(std::move(funObj), nullptr, params));
 }
 
+//! (static)
+std::pair<bool, ObjRef> tryCallMemberFunction(Runtime & runtime, ObjRef obj, StringId fnNameId, const ParameterValues & params) {
+	if(!obj){
+		runtime.setException("Can not call member '"+fnNameId.toString()+"' function without object.");
+		return std::make_pair(false,nullptr);
+	}
+	Attribute funAttr( std::move(obj->getAttribute(fnNameId)) );
+	if(!funAttr){
+		runtime.setException("No member to call "+obj.toDbgString()+".'"+fnNameId.toString()+"'(...).");
+		return std::make_pair(false,nullptr);
+	}
+	return std::move(runtime.tryExecuteFunction(funAttr.getValue(), std::move(obj), params));
+}
+
+//! (static)
+std::pair<bool, ObjRef> tryCallFunction(Runtime & runtime, ObjRef funObj, const ParameterValues & params) {
+	if( !funObj ){
+		runtime.setException("callFunction(nullptr): no function to call.");
+		return std::make_pair(false,nullptr);
+	}
+	return std::move(runtime.tryExecuteFunction(std::move(funObj), nullptr, params));
+}
+
 
 ////! (static)
 //void out(Object * obj) {
@@ -73,13 +98,9 @@ ObjRef callFunction(Runtime & runtime, ObjRef funObj, const ParameterValues & pa
 //	}
 //}
 
-//! (static)
-ObjRef _eval(Runtime & runtime, const CodeFragment & code,const std::unordered_map<StringId,ObjRef>& staticVars){
-	Compiler compiler(runtime.getLogger());
-	std::vector<StringId> staticVarNames;
-	for(auto & entry: staticVars)
-		staticVarNames.emplace_back(entry.first);
-	auto compileUnit = compiler.compile(code,staticVarNames);
+//! (static, internal) Assign the injected static variable values and execute the compiled script.
+static ObjRef executeCompileUnit(Runtime & runtime, const std::pair<ERef<UserFunction>,_CountedRef<StaticData>> & compileUnit,
+								const std::unordered_map<StringId,ObjRef>& staticVars){
 	UserFunction * script = compileUnit.first.get();
 	if(!script)
 		return nullptr;
@@ -98,10 +119,29 @@ ObjRef _eval(Runtime & runtime, const CodeFragment & code,const std::unordered_m
 	return runtime.executeFunction(script,nullptr,ParameterValues());
 }
 
+//! (static)
+ObjRef _eval(Runtime & runtime, const CodeFragment & code,const std::unordered_map<StringId,ObjRef>& staticVars){
+	Compiler compiler(runtime.getLogger());
+	std::vector<StringId> staticVarNames;
+	for(auto & entry: staticVars)
+		staticVarNames.emplace_back(entry.first);
+	return executeCompileUnit(runtime,compiler.compile(code,staticVarNames),staticVars);
+}
+
 
 //! (static)
 ObjRef _loadAndExecute(Runtime & runtime, const std::string & filename,const std::unordered_map<StringId,ObjRef>& staticVars) {
 	const StringData file = IO::loadFile(filename);
+	if(CodeImage::isCodeImage(file.str())){
+		// the static variables have to be declared when the image is created
+		auto compileUnit = CodeImage::load(file.str());
+		for(const auto & entry : staticVars){
+			const auto & names = compileUnit.second->getStaticVariableNames();
+			if(std::find(names.begin(),names.end(),entry.first)==names.end())
+				runtime.warn("Code image '"+filename+"' does not declare the static variable '"+entry.first.toString()+"'.");
+		}
+		return executeCompileUnit(runtime,compileUnit,staticVars);
+	}
 	return _eval(runtime,CodeFragment(StringId(filename),file),staticVars);
 }
 
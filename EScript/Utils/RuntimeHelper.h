@@ -73,6 +73,12 @@ template<class T> static T * assertType(Runtime & runtime, const ObjPtr & obj) {
 ObjRef callMemberFunction(Runtime & rt, ObjRef obj, StringId fnNameId, const ParameterValues & params);
 ObjRef callFunction(Runtime & rt, ObjRef fun, const ParameterValues & params);
 
+/*! Non-throwing variants of callMemberFunction(...) and callFunction(...).
+	@return (success, result) On failure, the exception remains pending in the runtime.
+	\see Runtime::tryExecuteFunction(...)	*/
+std::pair<bool, ObjRef> tryCallMemberFunction(Runtime & rt, ObjRef obj, StringId fnNameId, const ParameterValues & params);
+std::pair<bool, ObjRef> tryCallFunction(Runtime & rt, ObjRef fun, const ParameterValues & params);
+
 /*! Compile and execute the given code and return the result.
 	\note may throw 'std::exception' or 'Object *' on failure. */
 ObjRef _eval(Runtime & runtime, const CodeFragment & code,const std::unordered_map<StringId,ObjRef>& staticVars);
@@ -88,7 +94,8 @@ std::pair<bool, ObjRef> eval(Runtime & runtime, const StringData & code,const St
 //! @return (success, result)
 std::pair<bool, ObjRef> executeStream(Runtime & runtime, std::istream & stream);
 
-//! @return result (mmay throw an exception)
+/*! @return result (mmay throw an exception)
+	\note The file may either contain a script or a CodeImage of a compiled script.	*/
 ObjRef _loadAndExecute(Runtime & runtime, const std::string & filename,const std::unordered_map<StringId,ObjRef>& staticVars);
 
 //! @return (success, result)
@@ -49,9 +49,32 @@ StringData::Data * StringData::createData(const char * c,size_t size){
 	}
 }
 
+//! (static,internal)
+StringData::Data * StringData::createData(std::string && s){
+	if(s.empty())
+		return getEmptyData();
+	else if(dataPool.empty()){
+		return new Data(std::move(s),Data::UNKNOWN_UNICODE);
+	}else{
+		Data * d = dataPool.top();
+		dataPool.pop();
+		d->s = std::move(s);
+		d->dataType = Data::UNKNOWN_UNICODE;
+		d->numCodePoints = 0;
+		return d;
+	}
+}
+
+//! Pooled data objects keep their buffer only up to this capacity.
+static const size_t MAX_POOLED_CAPACITY = 1024;
+
 //! (static,internal)
 void StringData::releaseData(Data * data){
-	data->s.clear();
+	if(data->s.capacity()>MAX_POOLED_CAPACITY)
+		std::string().swap(data->s); // don't keep large buffers (e.g. loaded files) alive in the pool
+	else
+		data->s.clear();
+	data->jumpTable.reset();
 	dataPool.push(data);
 }
 
@@ -134,6 +157,11 @@ size_t StringData::getNumCodepoints()const{
 
 static const uint32_t JUMP_TABLE_STEP_SIZE = 8;
 
+void StringData::initCodePointInfo()const{
+	if(data->dataType == Data::UNKNOWN_UNICODE || data->dataType == Data::UNICODE_WITH_LENGTH)
+		initJumpTable();
+}
+
 //! (internal)
 void StringData::initJumpTable()const{
 	std::vector<size_t> jumpTable;
@@ -14,10 +14,10 @@
 #include <vector>
 #include <stack>
 #include <cstdint>
-
+
 #if defined(ES_THREADING)
 #include "SyncTools.h"
-#endif
+#endif
 
 namespace EScript {
 
@@ -26,11 +26,11 @@ class StringData{
 
 	//! internals
 		struct Data{
-			std::string s;
+			std::string s;
 			#if defined(ES_THREADING)
 			SyncTools::atomicInt referenceCounter;
 			#else
-			int referenceCounter;
+			int referenceCounter;
 			#endif
 			enum dataType_t{
 				RAW,					// the string consists of bytes without special semantic
@@ -47,6 +47,8 @@ class StringData{
 				s(_s),referenceCounter(0),dataType(t),numCodePoints(0){}
 			Data(const char * c,size_t size,dataType_t t) :
 				s(c,size),referenceCounter(0),dataType(t),numCodePoints(0){}
+			Data(std::string && _s,dataType_t t) :
+				s(std::move(_s)),referenceCounter(0),dataType(t),numCodePoints(0){}
 			Data(Data &&) = default;
 			Data(const Data &) = delete;
 			void initJumpTable(); //! \todo this is NOT thread safe!
@@ -54,6 +56,7 @@ class StringData{
 		};
 		static Data * createData(const std::string & s);
 		static Data * createData(const char * c,size_t size);
+		static Data * createData(std::string && s);
 		static void releaseData(Data * data);
 
 		void setData(Data * newData);
@@ -66,6 +69,8 @@ class StringData{
 		StringData() : data(getEmptyData())								{	++data->referenceCounter;	}
 		explicit StringData(const std::string & s) : data(createData(s)){	++data->referenceCounter;	}
 		explicit StringData(const char * c,size_t size) : data(createData(c,size)){	++data->referenceCounter;	}
+		//! Takes over the given string's buffer without copying it (e.g. for the content of large files).
+		explicit StringData(std::string && s) : data(createData(std::move(s))){	++data->referenceCounter;	}
 		StringData(const StringData & other) : data(other.data)			{	++data->referenceCounter;	}
 
 		~StringData(){
@@ -80,6 +85,9 @@ class StringData{
 		uint32_t getCodePoint(const size_t codePointIdx)const;
 		size_t getDataSize()const						{	return str().length();	}
 		size_t getNumCodepoints()const;
+		/*! Determine the code point information (normally done lazily on the first access).
+			Afterwards, the data is never modified by read operations; used for shared constants. */
+		void initCodePointInfo()const;
 		std::string getSubStr(const size_t codePointStart, const size_t numCodePoints)const;
 
 		bool beginsWith(const std::string& subj,const size_t codePointStart=0)const;
@@ -0,0 +1,113 @@
+// SyncTools.cpp
+// This file is part of the EScript programming language (https://github.com/EScript)
+//
+// Copyright (C) 2026 The EScript contributors
+//
+// Licensed under the MIT License. See LICENSE file for details.
+// ---------------------------------------------------------------------------------
+#if defined(ES_THREADING)
+
+#include "SyncTools.h"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace EScript{
+namespace SyncTools{
+
+namespace{
+//! The epoch of a thread's active read section (0 if no read section is active).
+//! The records are padded, so that the epochs of two records never share a cache line.
+struct ThreadRecord{
+	std::atomic<uint64_t> epoch;
+	bool used;
+	char padding[64-sizeof(std::atomic<uint64_t>)-sizeof(bool)];
+	ThreadRecord() : epoch(0),used(true){}
+};
+
+struct Reclamation{
+	std::atomic<uint64_t> globalEpoch;
+	std::mutex mutex;
+	std::vector<ThreadRecord*> threadRecords;	// never deleted; unused records are reused.
+	std::vector<std::pair<uint64_t,std::function<void()>>> retired;
+	Reclamation() : globalEpoch(1){}
+};
+Reclamation & getReclamation(){
+	static Reclamation * reclamation = new Reclamation; // never deleted, as data may be retired during static destruction
+	return *reclamation;
+}
+
+struct LocalThreadRecord{
+	ThreadRecord * record;
+	uint32_t nesting;
+	LocalThreadRecord() : record(nullptr),nesting(0){
+		Reclamation & reclamation = getReclamation();
+		std::lock_guard<std::mutex> lock(reclamation.mutex);
+		for(auto & r : reclamation.threadRecords){
+			if(!r->used){
+				r->used = true;
+				record = r;
+				return;
+			}
+		}
+		record = new ThreadRecord;
+		reclamation.threadRecords.push_back(record);
+	}
+	~LocalThreadRecord(){
+		Reclamation & reclamation = getReclamation();
+		std::lock_guard<std::mutex> lock(reclamation.mutex);
+		record->epoch.store(0);
+		record->used = false;
+	}
+};
+thread_local LocalThreadRecord localThreadRecord;
+}
+
+//! (static,internal)
+void ReadSection::enterReadSection(){
+	LocalThreadRecord & local = localThreadRecord;
+	if(local.nesting++ == 0)
+		local.record->epoch.store(getReclamation().globalEpoch.load());
+}
+
+//! (static,internal)
+void ReadSection::leaveReadSection(){
+	LocalThreadRecord & local = localThreadRecord;
+	if(--local.nesting == 0)
+		local.record->epoch.store(0,std::memory_order_release);
+}
+
+void retire(std::function<void()> && deleter){
+	Reclamation & reclamation = getReclamation();
+	std::vector<std::function<void()>> deleters;
+	{
+		std::lock_guard<std::mutex> lock(reclamation.mutex);
+		// read sections entered after this point can not access the replaced data
+		reclamation.retired.emplace_back(reclamation.globalEpoch.fetch_add(1),std::move(deleter));
+
+		uint64_t minEpoch = std::numeric_limits<uint64_t>::max();
+		for(const auto & record : reclamation.threadRecords){
+			const uint64_t epoch = record->epoch.load();
+			if(epoch!=0 && epoch<minEpoch)
+				minEpoch = epoch;
+		}
+		auto & retired = reclamation.retired;
+		size_t remaining = 0;
+		for(auto & entry : retired){
+			if(entry.first<minEpoch)
+				deleters.emplace_back(std::move(entry.second));
+			else
+				retired[remaining++] = std::move(entry);
+		}
+		retired.resize(remaining);
+	}
+	// the deleters are called without holding the lock, as they may retire other data.
+	for(auto & d : deleters)
+		d();
+}
+
+}
+}
+#endif // ES_THREADING
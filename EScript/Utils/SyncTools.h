@@ -11,6 +11,7 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <functional>
 
 namespace EScript{
 namespace SyncTools{
@@ -38,6 +39,51 @@ inline SyncTools::FastLockHolder tryLock(FastLock& lock){
 	return std::move(FastLockHolder(lock, std::try_to_lock) );
 }
 
+#if defined(ES_THREADING)
+/*! Read section for data that is published by replacing it (read-copy-update) and read without locking.
+	Entering and leaving a read section only writes to a thread local counter; sections may be nested.
+	Data that has been replaced has to be passed to retire(...) and is deleted as soon as no read section
+	that may still access it is active (epoch based reclamation).	*/
+class ReadSection{
+		bool active;
+	public:
+		ReadSection() : active(false)	{}
+		ReadSection(ReadSection && other) : active(other.active)	{	other.active = false;	}
+		ReadSection(const ReadSection &) = delete;
+		~ReadSection()					{	leave();	}
+		ReadSection & operator=(ReadSection && other){
+			if(this!=&other){
+				leave();
+				active = other.active;
+				other.active = false;
+			}
+			return *this;
+		}
+		ReadSection & operator=(const ReadSection &) = delete;
+
+		void enter(){
+			if(!active){
+				enterReadSection();
+				active = true;
+			}
+		}
+		void leave(){
+			if(active){
+				leaveReadSection();
+				active = false;
+			}
+		}
+	private:
+		static void enterReadSection();
+		static void leaveReadSection();
+};
+
+/*! Delete replaced data (by calling @p deleter) when all read sections that were active
+	when the new data has been published are left.
+	\note The new data has to be published before calling this function.	*/
+void retire(std::function<void()> && deleter);
+#endif // ES_THREADING
+
 }
 }
 
@@ -11,6 +11,7 @@
 #include "../EScript/StdObjects.h"
 #include "../EScript/Utils/IO/IO.h"
 #include "../EScript/Utils/StringUtils.h"
+#include <memory>
 
 namespace EScript{
 
@@ -24,6 +25,136 @@ static const uint32_t E_DIR_DIRECTORIES = 2;
 static const uint32_t E_DIR_BOTH = 3;
 static const uint32_t E_DIR_RECURSIVE = 4;
 
+static const int E_SEEK_SET = 0;
+static const int E_SEEK_CUR = 1;
+static const int E_SEEK_END = 2;
+
+// ---------------------------------------------------
+
+//! [File] ---|> [Object]  A file opened for streamed (buffered) reading and writing.
+class E_File : public Object{
+		ES_PROVIDES_TYPE_NAME(File)
+	public:
+		//! (static)
+		static Type * getTypeObject(){
+			static Type * typeObject = new Type(Object::getTypeObject()); // ---|> Object
+			return typeObject;
+		}
+		//! (static) Convert a fopen-like mode string ("r","w","a","r+","w+","a+") into an openmode.
+		static std::ios_base::openmode toOpenMode(const std::string & mode){
+			if(mode=="r")
+				return std::ios::in;
+			else if(mode=="w")
+				return std::ios::out | std::ios::trunc;
+			else if(mode=="a")
+				return std::ios::out | std::ios::app;
+			else if(mode=="r+")
+				return std::ios::in | std::ios::out;
+			else if(mode=="w+")
+				return std::ios::in | std::ios::out | std::ios::trunc;
+			else if(mode=="a+")
+				return std::ios::in | std::ios::out | std::ios::app;
+			throw std::invalid_argument("Invalid file mode: '"+mode+'\'');
+		}
+
+		E_File(const std::string & _filename,const std::string & mode) :
+				Object(getTypeObject()), filename(_filename), stream(IO::openStream(filename,toOpenMode(mode))){}
+		virtual ~E_File(){}
+
+		const std::string & getFilename()const	{	return filename;	}
+		bool isOpen()const						{	return static_cast<bool>(stream);	}
+		void close()							{	stream.reset();	}
+
+		//! @throw std::ios_base::failure if the file has been closed.
+		std::iostream & getStream(){
+			if(!stream)
+				throw std::ios_base::failure("File is closed: '"+filename+'\'');
+			return *stream.get();
+		}
+
+		//! Read up to @p numBytes bytes.
+		std::string read(size_t numBytes){
+			std::string s(numBytes,'\0');
+			getStream().read(&s[0],numBytes);
+			s.resize(static_cast<size_t>(getStream().gcount()));
+			return s;
+		}
+		//! Read the remaining content.
+		std::string readAll(){
+			std::string s;
+			char buffer[4096];
+			do{
+				getStream().read(buffer,sizeof(buffer));
+				s.append(buffer,static_cast<size_t>(getStream().gcount()));
+			}while(getStream());
+			return s;
+		}
+		/*! Read the next line without its line break into @p line.
+			@return false iff the end of the file has been reached before.	*/
+		bool readLine(std::string & line){
+			if(!std::getline(getStream(),line))
+				return false;
+			if(!line.empty() && line.back()=='\r')
+				line.pop_back();
+			return true;
+		}
+		void write(const std::string & s){
+			if(!getStream().write(s.data(),s.length()))
+				throw std::ios_base::failure("Could not write to file: '"+filename+'\'');
+		}
+		void flush()							{	getStream().flush();	}
+		void seek(double pos,std::ios_base::seekdir dir){
+			std::iostream & s = getStream();
+			s.clear(); // reset eof
+			s.seekg(static_cast<std::streamoff>(pos),dir);
+			s.seekp(static_cast<std::streamoff>(pos),dir);
+		}
+		double tell(){
+			std::iostream & s = getStream();
+			const std::streamoff pos = s.tellg();
+			return static_cast<double>(pos>=0 ? pos : static_cast<std::streamoff>(s.tellp()));
+		}
+		bool isEOF(){
+			std::iostream & s = getStream();
+			return !s || s.peek()==std::char_traits<char>::eof();
+		}
+	private:
+		std::string filename;
+		std::unique_ptr<std::iostream> stream;
+};
+
+//! [FileLineIterator] ---|> [Iterator]  Reads the lines of a file on demand.
+class E_FileLineIterator : public Iterator{
+		ES_PROVIDES_TYPE_NAME(FileLineIterator)
+	public:
+		//! (static)
+		static Type * getTypeObject(){
+			static Type * typeObject = new Type(Iterator::getTypeObject()); // ---|> Iterator
+			return typeObject;
+		}
+		E_FileLineIterator(E_File * _file) : Iterator(getTypeObject()), file(_file), lineNumber(0), atEnd(false){
+			next();
+			lineNumber = 0;
+		}
+		virtual ~E_FileLineIterator(){}
+
+		//! ---|> Iterator
+		Object * key() override		{	return atEnd ? nullptr : create(static_cast<uint32_t>(lineNumber));	}
+		Object * value() override	{	return atEnd ? nullptr : create(line);	}
+		void next() override{
+			if(!atEnd){
+				atEnd = !file->readLine(line);
+				++lineNumber;
+			}
+		}
+		bool end() override			{	return atEnd;	}
+	private:
+		ERef<E_File> file;
+		std::string line;
+		size_t lineNumber;
+		bool atEnd;
+};
+
 // ---------------------------------------------------
 
 //! init
@@ -66,6 +197,16 @@ void IOLib::init(EScript::Namespace * o) {
 	})
 	declareConstant(lib,"filePutContents",lib->getAttribute("saveTextFile").getValue()); //! \deprecated alias
 
+	//! [ESF] void deleteFile(string filename)
+	ES_FUNCTION(lib,"deleteFile",1,1,{
+		try{
+			IO::deleteFile(parameter[0].toString());
+		}catch(const std::ios::failure & e){
+			rt.setException(e.what());
+		}
+		return nullptr;
+	})
+
 	//! [ESF] array dir(string dirname[,int flags])
 	ES_FUNCTION(lib,"dir",1,2, {
 		try {
@@ -95,11 +236,66 @@ void IOLib::init(EScript::Namespace * o) {
 	ES_FUN(lib,"dirname", 1, 1,IO::dirname(parameter[0].toString()))
 	// rename
 	// copy
-	// delete
 	declareConstant(lib,"DIR_FILES",		static_cast<uint32_t>(E_DIR_FILES));
 	declareConstant(lib,"DIR_DIRECTORIES",	static_cast<uint32_t>(E_DIR_DIRECTORIES));
 	declareConstant(lib,"DIR_BOTH",			static_cast<uint32_t>(E_DIR_BOTH));
 	declareConstant(lib,"DIR_RECURSIVE",	static_cast<uint32_t>(E_DIR_RECURSIVE));
 
+	{ // file
+		Type * typeObject = E_File::getTypeObject();
+		initPrintableName(typeObject,E_File::getClassName());
+		declareConstant(lib,E_File::getClassName(),typeObject);
+
+		//! [ESMF] new IO.File(string filename[,string mode="r"])	mode: "r","w","a","r+","w+","a+"
+		ES_CTOR(typeObject,1,2,new E_File(parameter[0].toString(),parameter[1].toString("r")))
+
+		//! [ESMF] self File.close()
+		ES_MFUN(typeObject,E_File,"close",0,0,(thisObj->close(),thisEObj))
+
+		//! [ESMF] self File.flush()
+		ES_MFUN(typeObject,E_File,"flush",0,0,(thisObj->flush(),thisEObj))
+
+		//! [ESMF] string File.getFilename()
+		ES_MFUN(typeObject,const E_File,"getFilename",0,0,thisObj->getFilename())
+
+		//! [ESMF] bool File.isEOF()
+		ES_MFUN(typeObject,E_File,"isEOF",0,0,thisObj->isEOF())
+
+		//! [ESMF] bool File.isOpen()
+		ES_MFUN(typeObject,const E_File,"isOpen",0,0,thisObj->isOpen())
+
+		//! [ESMF] Iterator File.lines()	Iterates over the remaining lines (usable with foreach).
+		ES_MFUN(typeObject,E_File,"lines",0,0,new E_FileLineIterator(thisObj))
+
+		//! [ESMF] string File.read([number of bytes])	Without parameter, the remaining content is read.
+		ES_MFUN(typeObject,E_File,"read",0,1,
+				parameter.count()>0 ? thisObj->read(parameter[0].toUInt()) : thisObj->readAll())
+
+		//! [ESMF] string|void File.readLine()	Returns void at the end of the file.
+		ES_MFUNCTION(typeObject,E_File,"readLine",0,0,{
+			std::string line;
+			if(!thisObj->readLine(line))
+				return nullptr;
+			return line;
+		})
+
+		//! [ESMF] self File.seek(number position[,int origin=IO.SEEK_SET])
+		ES_MFUNCTION(typeObject,E_File,"seek",1,2,{
+			const int origin = parameter[1].toInt(E_SEEK_SET);
+			thisObj->seek(parameter[0].toDouble(),
+					origin==E_SEEK_CUR ? std::ios::cur : (origin==E_SEEK_END ? std::ios::end : std::ios::beg));
+			return thisEObj;
+		})
+
+		//! [ESMF] number File.tell()
+		ES_MFUN(typeObject,E_File,"tell",0,0,thisObj->tell())
+
+		//! [ESMF] self File.write(string)
+		ES_MFUN(typeObject,E_File,"write",1,1,(thisObj->write(parameter[0].toString()),thisEObj))
+	}
+	declareConstant(lib,"SEEK_SET",	E_SEEK_SET);
+	declareConstant(lib,"SEEK_CUR",	E_SEEK_CUR);
+	declareConstant(lib,"SEEK_END",	E_SEEK_END);
+
 }
 }
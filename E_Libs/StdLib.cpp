@@ -11,6 +11,7 @@
 #include "../EScript/Basics.h"
 #include "../EScript/StdObjects.h"
 #include "../EScript/Objects/Callables/UserFunction.h"
+#include "../EScript/Compiler/CodeImage.h"
 #include "../EScript/Compiler/Compiler.h"
 #include "../EScript/Utils/IO/IO.h"
 #include "../EScript/Utils/StringUtils.h"
@@ -209,6 +210,23 @@ void StdLib::init(EScript::Namespace * globals) {
 	#endif
 	}
 
+	/*!	[ESF]  void compileToImage(String scriptFile, String imageFile[, Array staticVariableNames])
+		Compile the script and save the compiled code as CodeImage, which can be executed by load(...)
+		and loadOnce(...) without compiling it again. Static variables that are passed to load(...)
+		have to be declared when the image is created.	*/
+	ES_FUNCTION(globals,"compileToImage",2,3,{
+		const std::string scriptFile( IO::condensePath(findFile(rt,parameter[0].toString())) );
+		std::vector<StringId> staticVarNames;
+		if(parameter.count() > 2){
+			for(const auto & name : *parameter[2].to<const Array*>(rt))
+				staticVarNames.emplace_back(name.toString());
+		}
+		Compiler compiler(rt.getLogger());
+		auto compileUnit = compiler.compile(CodeFragment(StringId(scriptFile),IO::loadFile(scriptFile)),staticVarNames);
+		IO::saveFile(parameter[1].toString(),CodeImage::create(compileUnit.first.get(),compileUnit.second.get()));
+		return nullptr;
+	})
+
 	typedef std::unordered_map<StringId,ObjRef> staticVarMap_t;
 	//!	[ESF]  Object eval(string, Map _staticVariables)
 	ES_FUNCTION(globals,"eval",1,2,{
@@ -309,7 +327,12 @@ void StdLib::init(EScript::Namespace * globals) {
 		return compileUnit.first.detachAndDecrease();
 	})
 	//! [ESF]  obj parseJSON(string)
-	ES_FUN(globals,"parseJSON",1,1,JSON::parseJSON(parameter[0].toString()))
+	ES_FUNCTION(globals,"parseJSON",1,1,{
+		// parse a string object's data in place to avoid copying large documents
+		if(String * str = parameter[0].castTo<String>())
+			return JSON::parseJSON(str->_getStringData().str());
+		return JSON::parseJSON(parameter[0].toString());
+	})
 
 	//! [ESF] void print_r(...)
 	ES_FUNCTION(globals,"print_r",0,-1, {